@@ -0,0 +1,148 @@
+#include "Baseline.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    //! How many standard errors apart two means have to be, to be told apart from noise with 95% confidence (two-sided),
+    //! with `degreesOfFreedom`. Student's t-distribution, rounded down to the next df in the table, which only ever asks for more.
+    double SignificantT(const double degreesOfFreedom) {
+        static constexpr double table[] = {
+            12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+            2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+            2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+        };
+
+        if (degreesOfFreedom < 1)
+            return table[0];
+        if (degreesOfFreedom < 31)
+            return table[static_cast<std::size_t>(degreesOfFreedom) - 1];
+        if (degreesOfFreedom < 40)
+            return 2.042;
+        if (degreesOfFreedom < 60)
+            return 2.021;
+        if (degreesOfFreedom < 120)
+            return 2.000;
+
+        return 1.980;
+    }
+
+    //! The number following `"key": ` within `object`, or 0
+    double NumberField(const std::string& object, const std::string& key) {
+        const std::size_t pos = object.find("\"" + key + "\":");
+        if (pos == std::string::npos)
+            return 0;
+
+        return std::strtod(object.c_str() + pos + key.length() + 3, nullptr);
+    }
+}
+
+std::vector<BenchmarkResult> LoadBaseline(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file)
+        throw std::runtime_error("Can't read baseline " + path);
+
+    std::stringstream ss;
+    ss << file.rdbuf();
+    const std::string json = ss.str();
+
+    // It's our own format, so every benchmark is a flat object with a name
+    std::vector<BenchmarkResult> results;
+    for (std::size_t pos = json.find("\"name\": \""); pos != std::string::npos; pos = json.find("\"name\": \"", pos + 1))
+    {
+        const std::size_t begin = json.rfind('{', pos);
+        const std::size_t end = json.find('}', pos);
+        const std::string object = json.substr(begin, end - begin);
+
+        const std::size_t nameBegin = pos + 9;
+        BenchmarkResult result;
+        result.name = json.substr(nameBegin, json.find('"', nameBegin) - nameBegin);
+        result.mbPerSecond = NumberField(object, "mbPerSecond");
+        result.mbPerSecondStddev = NumberField(object, "mbPerSecondStddev");
+        result.samples = static_cast<std::size_t>(NumberField(object, "samples"));
+
+        // Nothing to compare against, without a throughput
+        if (result.mbPerSecond > 0)
+            results.push_back(result);
+    }
+
+    // An empty or garbled baseline would pass any comparison
+    if (results.empty())
+        throw std::runtime_error("No benchmarks in baseline " + path);
+
+    return results;
+}
+
+bool CompareToBaseline(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current, double thresholdPercent)
+{
+    // Comparing against a baseline of entirely different benchmarks would pass, without comparing anything
+    const bool anyMatch = std::any_of(current.begin(), current.end(), [&baseline](const BenchmarkResult& now) {
+        return std::any_of(baseline.begin(), baseline.end(), [&now](const BenchmarkResult& before) { return before.name == now.name; });
+    });
+    if (!anyMatch)
+        throw std::runtime_error("None of the benchmarks are in the baseline");
+
+    bool regressed = false;
+
+    std::fprintf(stderr, "%-48s %20s %20s %9s\n", "benchmark", "baseline MB/s", "current MB/s", "delta");
+    for (const BenchmarkResult& now : current)
+    {
+        const BenchmarkResult* before = nullptr;
+        for (const BenchmarkResult& b : baseline)
+            if (b.name == now.name)
+                before = &b;
+
+        if (before == nullptr)
+        {
+            std::fprintf(stderr, "%-48s %20s %11.3f ± %6.3f   (new)\n", now.name.c_str(), "-", now.mbPerSecond, now.mbPerSecondStddev);
+            continue;
+        }
+
+        const double delta = (now.mbPerSecond - before->mbPerSecond) / before->mbPerSecond * 100;
+
+        // Welch's t-test: How many standard errors the means are apart, and how many of them it takes, for how many samples there are.
+        // A single sample says nothing about the noise, so nothing counts without at least two on either side
+        bool significant = false;
+        if ((before->samples >= 2) && (now.samples >= 2))
+        {
+            const double varianceBefore = before->mbPerSecondStddev * before->mbPerSecondStddev / static_cast<double>(before->samples);
+            const double varianceNow = now.mbPerSecondStddev * now.mbPerSecondStddev / static_cast<double>(now.samples);
+            const double standardError = std::sqrt(varianceBefore + varianceNow);
+
+            if (standardError > 0)
+            {
+                // Welch–Satterthwaite
+                const double degreesOfFreedom = (varianceBefore + varianceNow) * (varianceBefore + varianceNow) / (
+                        varianceBefore * varianceBefore / static_cast<double>(before->samples - 1) +
+                        varianceNow * varianceNow / static_cast<double>(now.samples - 1)
+                );
+
+                significant = std::fabs(now.mbPerSecond - before->mbPerSecond) / standardError > SignificantT(degreesOfFreedom);
+            }
+            else
+                significant = (delta != 0);
+        }
+
+        const char* verdict = "(noise)";
+        if ((significant) && (delta < -thresholdPercent))
+        {
+            verdict = "REGRESSION";
+            regressed = true;
+        }
+        else if ((significant) && (delta < 0))
+            verdict = "slower";
+        else if (significant)
+            verdict = "faster";
+
+        std::fprintf(stderr, "%-48s %11.3f ± %6.3f %11.3f ± %6.3f %+8.1f%%  %s\n",
+                     now.name.c_str(), before->mbPerSecond, before->mbPerSecondStddev, now.mbPerSecond, now.mbPerSecondStddev, delta, verdict);
+    }
+
+    return regressed;
+}
@@ -0,0 +1,26 @@
+#ifndef UWWWU_BASELINE_H
+#define UWWWU_BASELINE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+//! One benchmark's throughput, over a few samples
+struct BenchmarkResult {
+    std::string name;
+    double mbPerSecond = 0;
+    double mbPerSecondStddev = 0;
+    std::size_t samples = 0;
+};
+
+//! Reads the benchmarks from JSON written by UwuBench (with --save, or just its stdout).
+//! Throws std::runtime_error if the file can't be read, or doesn't hold a single benchmark.
+std::vector<BenchmarkResult> LoadBaseline(const std::string& path);
+
+//! Prints how every benchmark in `current` compares to the same one in `baseline`, to stderr.
+//! A difference only counts if it stands out of the noise of both runs (Welch's t-test, at 95% confidence), which takes at least two samples each.
+//! Returns whether any benchmark got significantly slower, by more than `thresholdPercent`.
+//! Throws std::runtime_error if none of the benchmarks in `current` are in `baseline`, as there'd be nothing compared.
+bool CompareToBaseline(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current, double thresholdPercent);
+
+#endif //UWWWU_BASELINE_H
@@ -0,0 +1,49 @@
+#include <CharTable.h>
+#include <CharTools.h>
+#include "Corpus.h"
+#include "Catch2.h"
+#include <cstddef>
+#include <string>
+
+// Compares uwu's own char tables with the CharTools predicates they replace, char by char over 1 MiB of text
+TEST_CASE(__FILE__"/CharTableVsCharTools", "[benchmark]")
+{
+    const std::string text = CorpusGenerator({ .seed = 5 }).Text(1 << 20);
+
+    // Counting, so that there is something to return
+    const auto count = [&text](auto predicate) {
+        std::size_t n = 0;
+        for (const char c : text)
+            n += predicate(c);
+
+        return n;
+    };
+
+    // Both have to agree, or there is nothing to compare
+    REQUIRE(count([](char c) { return CharTools::IsVowel(c); }) == count([](char c) { return CharTable::IsVowel(c); }));
+
+    BENCHMARK("IsLetter, CharTools, 1 MiB") { return count([](char c) { return CharTools::IsLetter(c); }); };
+    BENCHMARK("IsLetter, CharTable, 1 MiB") { return count([](char c) { return CharTable::IsLetter(c); }); };
+
+    BENCHMARK("IsVowel, CharTools, 1 MiB") { return count([](char c) { return CharTools::IsVowel(c); }); };
+    BENCHMARK("IsVowel, CharTable, 1 MiB") { return count([](char c) { return CharTable::IsVowel(c); }); };
+
+    BENCHMARK("MakeLower, CharTools, 1 MiB") { return count([](char c) { return CharTools::MakeLower(c) == 'e'; }); };
+    BENCHMARK("MakeLower, CharTable, 1 MiB") { return count([](char c) { return CharTable::MakeLower(c) == 'e'; }); };
+
+    // Every char takes the case of the one before it
+    BENCHMARK("CopySign, CharTools, 1 MiB") {
+        std::size_t n = 0;
+        for (std::size_t i = 1; i < text.length(); i++)
+            n += static_cast<unsigned char>(CharTools::CopySign(text[i - 1], text[i]));
+
+        return n;
+    };
+    BENCHMARK("CopySign, CharTable, 1 MiB") {
+        std::size_t n = 0;
+        for (std::size_t i = 1; i < text.length(); i++)
+            n += static_cast<unsigned char>(CharTable::CopySign(text[i - 1], text[i]));
+
+        return n;
+    };
+}
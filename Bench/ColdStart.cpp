@@ -0,0 +1,83 @@
+// Cold-start benchmark: execs a binary over and over, and prints the wall time from exec to exit as JSON.
+// Usage: UwuColdStart [--runs N] <binary> [args...]
+// The binary's stdout goes to /dev/null.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+namespace {
+    double Percentile(std::vector<double> values, double p) {
+        const std::size_t index = std::min(values.size() - 1, static_cast<std::size_t>(p * values.size()));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+
+        return values[index];
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t runs = 2000;
+    int firstArg = 1;
+    if ((argc > 2) && (std::strcmp(argv[1], "--runs") == 0))
+    {
+        runs = std::max<std::size_t>(std::strtoull(argv[2], nullptr, 10), 1);
+        firstArg = 3;
+    }
+
+    if (firstArg >= argc)
+    {
+        std::fprintf(stderr, "Usage: UwuColdStart [--runs N] <binary> [args...]\n");
+        return 1;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+
+    std::vector<double> times;
+    times.reserve(runs);
+    for (std::size_t run = 0; run < runs; run++)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+
+        pid_t pid;
+        if (posix_spawn(&pid, argv[firstArg], &actions, nullptr, argv + firstArg, environ) != 0)
+        {
+            std::fprintf(stderr, "Can't exec %s\n", argv[firstArg]);
+            return 1;
+        }
+
+        int status;
+        waitpid(pid, &status, 0);
+
+        times.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count());
+
+        if ((!WIFEXITED(status)) || (WEXITSTATUS(status) != 0))
+        {
+            std::fprintf(stderr, "%s failed\n", argv[firstArg]);
+            return 1;
+        }
+    }
+
+    posix_spawn_file_actions_destroy(&actions);
+
+    double mean = 0;
+    for (const double time : times)
+        mean += time / static_cast<double>(runs);
+
+    std::printf("{\"runs\": %zu, \"minMicroseconds\": %.1f, \"p50Microseconds\": %.1f, \"p99Microseconds\": %.1f, \"maxMicroseconds\": %.1f, \"meanMicroseconds\": %.1f}\n",
+                runs, *std::min_element(times.begin(), times.end()), Percentile(times, 0.5), Percentile(times, 0.99),
+                *std::max_element(times.begin(), times.end()), mean);
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include "Corpus.h"
+#include <Util.h>
+#include <CharTools.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    //! Words that trigger at least one rule
+    const std::vector<std::string> triggerWords = {
+        // "th"
+        "the", "that", "this", "with", "think", "other", "them",
+        // "n" + vowel, and the "one" exception
+        "nine", "one", "none", "any", "money", "nice", "nose", "into",
+        // Trailing "er", and "r" around vowels
+        "never", "river", "water", "tiger", "after", "very", "around", "carry",
+        // "ove", "have", "tr", "up", "hi", "ay", "ey"
+        "love", "glove", "have", "try", "tree", "up", "super", "hi", "say", "day", "hey", "they",
+        // "y" + vowel
+        "yes", "you", "yellow", "yard",
+        // "c" between vowels, "l" and "ll"
+        "nicer", "decide", "rally", "silly", "Larry", "little", "look", "all", "wally",
+        // The complete-word vocabulary
+        "thank you", "thanks", "good", "well", "emacs", "hello", "dear",
+        // Language
+        "c++"
+    };
+
+    //! Words that trigger none
+    const std::vector<std::string> fillerWords = {
+        "a", "at", "as", "is", "it", "to", "do", "so", "go", "we", "me", "be", "if", "of", "us",
+        "big", "dog", "sad", "fog", "bus", "mud", "box", "kid", "bad", "odd", "its", "was", "had",
+        "did", "get", "set", "put", "but", "just", "ask", "kiss", "fast", "best", "west", "most",
+        "past", "desk", "gift", "mask", "sock", "quiz", "pig", "jug", "sum", "bag", "cat", "hat"
+    };
+
+    const std::vector<std::string> punctuation = { ",", ".", "!", "?" };
+    const std::vector<std::string> emoticons = { " :)", " :D", " :-)", " ^^" };
+}
+
+CorpusGenerator::CorpusGenerator(Options options)
+    : options(options)
+{
+}
+
+double CorpusGenerator::Uniform()
+{
+    // 53 bits, so that every value is exactly representable
+    return static_cast<double>(Util::Random(options.seed, counter++) >> 11) / static_cast<double>(std::uint64_t(1) << 53);
+}
+
+std::string CorpusGenerator::Word()
+{
+    const std::vector<std::string>& pool = (Uniform() < options.triggerDensity) ? triggerWords : fillerWords;
+    std::string word = pool[static_cast<std::size_t>(Uniform() * pool.size())];
+
+    const double caps = Uniform();
+    if (caps < options.allCapsDensity)
+        for (char& c : word)
+            c = CharTools::MakeUpper(c);
+    else if (caps < options.allCapsDensity + options.capitalisedDensity)
+        word[0] = CharTools::MakeUpper(word[0]);
+
+    if (Uniform() < options.punctuationDensity)
+        word += punctuation[static_cast<std::size_t>(Uniform() * punctuation.size())];
+    if (Uniform() < options.emoticonDensity)
+        word += emoticons[static_cast<std::size_t>(Uniform() * emoticons.size())];
+
+    return word;
+}
+
+std::string CorpusGenerator::Line()
+{
+    // Exponentially distributed, and at least one word
+    const double words = 1 - options.meanWordsPerLine * std::log(1 - Uniform());
+    const std::size_t count = std::min(static_cast<std::size_t>(words), std::max<std::size_t>(options.maxWordsPerLine, 1));
+
+    std::string line;
+    for (std::size_t i = 0; i < count; i++)
+    {
+        if (i > 0)
+            line += ' ';
+        line += Word();
+    }
+
+    return line;
+}
+
+std::vector<std::string> CorpusGenerator::Lines(std::size_t count)
+{
+    std::vector<std::string> lines;
+    lines.reserve(count);
+    for (std::size_t i = 0; i < count; i++)
+        lines.push_back(Line());
+
+    return lines;
+}
+
+std::string CorpusGenerator::Text(std::size_t bytes)
+{
+    std::string text;
+    text.reserve(bytes + options.maxWordsPerLine * 16);
+    while (text.length() < bytes)
+    {
+        text += Line();
+        text += '\n';
+    }
+    text.resize(bytes);
+
+    return text;
+}
+
+std::vector<CorpusGenerator::AdversarialInput> CorpusGenerator::Adversarial(std::size_t bytes)
+{
+    const std::vector<AdversarialInput> patterns = {
+        // Every byte rolls the decoration's dice
+        { "dots", "." },
+        { "punctuation", ".!,?" },
+        // Every byte is a finding, asking a validator
+        { "n-run", "n" },
+        { "r-run", "r" },
+        { "l-run", "l" },
+        // Every finding gets accepted and expanded
+        { "n-vowel", "na" },
+        { "r-vowel", "ara" },
+        { "ll-vowel", "lla" },
+        { "y-vowel", "ya " },
+        // Expansions that feed more findings into later rules
+        { "hi", "hi" },
+        { "th", "th" },
+        { "thank-you", "ThAnK yOu " },
+        { "ay-ey", "ayey" },
+        // Matches overlapping one another
+        { "emoticons", ":):-):D^^^" },
+        { "c++", "c++" },
+        // A single word without any finding, and no word break for the validators to stop at
+        { "one-word", "a" }
+    };
+
+    std::vector<AdversarialInput> inputs;
+    for (const AdversarialInput& pattern : patterns)
+    {
+        std::string text;
+        text.reserve(bytes + pattern.text.length());
+        while (text.length() < bytes)
+            text += pattern.text;
+        text.resize(bytes);
+
+        inputs.push_back({ pattern.name, std::move(text) });
+    }
+
+    return inputs;
+}
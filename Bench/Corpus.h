@@ -0,0 +1,65 @@
+#ifndef UWWWU_CORPUS_H
+#define UWWWU_CORPUS_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+//! Makes up English-like text, for benchmarks and tests to chew on.
+//! Random bytes are useless here, because the rules only fire on digraphs, whole words, punctuation and emoticons.
+//! So the text is made of words that trigger rules, and filler words that trigger none, in a controllable mix.
+//! The same options always make up the very same text, on every platform, so there are no fixtures to commit.
+class CorpusGenerator {
+public:
+    struct Options {
+        std::uint64_t seed = 0;
+
+        //! Chance of a word being one that triggers a rule ("th", "n" + vowel, trailing "er", "y" + vowel, ...), rather than filler
+        double triggerDensity = 0.3;
+        //! Chance of a word being followed by punctuation
+        double punctuationDensity = 0.1;
+        //! Chance of a word being followed by an emoticon
+        double emoticonDensity = 0.02;
+        //! Chance of a word being Capitalised
+        double capitalisedDensity = 0.1;
+        //! Chance of a word being ALL CAPS
+        double allCapsDensity = 0.02;
+
+        //! Line lengths, in words, are exponentially distributed around this, so most lines are short, and a few are long
+        double meanWordsPerLine = 12;
+        std::size_t maxWordsPerLine = 1000;
+    };
+
+    explicit CorpusGenerator(Options options);
+
+    //! The next line, without a newline
+    std::string Line();
+
+    //! The next `count` lines
+    std::vector<std::string> Lines(std::size_t count);
+
+    //! The next lines, each terminated by a newline, cut to exactly `bytes` bytes
+    std::string Text(std::size_t bytes);
+
+    //! An input built to be as expensive as possible for some rule
+    struct AdversarialInput {
+        std::string name;
+        std::string text;
+    };
+
+    //! Worst cases for the rules, each `bytes` bytes long: runs of punctuation, of chars that trigger a validator
+    //! and an expansion on every single byte, of expansions feeding later rules, and of whole-word matches.
+    //! There's no randomness here, they're just patterns, repeated.
+    static std::vector<AdversarialInput> Adversarial(std::size_t bytes);
+
+private:
+    //! Uniformly distributed in [0, 1)
+    double Uniform();
+    std::string Word();
+
+    Options options;
+    std::uint64_t counter = 0;
+};
+
+#endif //UWWWU_CORPUS_H
@@ -0,0 +1,68 @@
+// Prints a made-up corpus to stdout, for feeding it to Uwwwu, or to anything else.
+// Usage: UwuCorpus [--seed N] [--lines N | --bytes N] [--trigger-density X] [--punctuation-density X]
+//                  [--emoticon-density X] [--capitalised-density X] [--all-caps-density X] [--mean-words X] [--max-words N]
+
+#include "Corpus.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+int main(int argc, char** argv) {
+    CorpusGenerator::Options options;
+    std::size_t lines = 1000;
+    std::size_t bytes = 0;
+
+    for (int i = 1; i < argc; i += 2)
+    {
+        const char* const name = argv[i];
+        if (i + 1 == argc)
+        {
+            std::fprintf(stderr, "Missing value for: %s\n", name);
+            return 1;
+        }
+        const char* const value = argv[i + 1];
+
+        if (std::strcmp(name, "--seed") == 0)
+            options.seed = std::strtoull(value, nullptr, 10);
+        else if (std::strcmp(name, "--lines") == 0)
+            lines = std::strtoull(value, nullptr, 10);
+        else if (std::strcmp(name, "--bytes") == 0)
+            bytes = std::strtoull(value, nullptr, 10);
+        else if (std::strcmp(name, "--trigger-density") == 0)
+            options.triggerDensity = std::strtod(value, nullptr);
+        else if (std::strcmp(name, "--punctuation-density") == 0)
+            options.punctuationDensity = std::strtod(value, nullptr);
+        else if (std::strcmp(name, "--emoticon-density") == 0)
+            options.emoticonDensity = std::strtod(value, nullptr);
+        else if (std::strcmp(name, "--capitalised-density") == 0)
+            options.capitalisedDensity = std::strtod(value, nullptr);
+        else if (std::strcmp(name, "--all-caps-density") == 0)
+            options.allCapsDensity = std::strtod(value, nullptr);
+        else if (std::strcmp(name, "--mean-words") == 0)
+            options.meanWordsPerLine = std::strtod(value, nullptr);
+        else if (std::strcmp(name, "--max-words") == 0)
+            options.maxWordsPerLine = std::strtoull(value, nullptr, 10);
+        else
+        {
+            std::fprintf(stderr, "Unknown option: %s\n", name);
+            return 1;
+        }
+    }
+
+    CorpusGenerator generator(options);
+
+    if (bytes > 0)
+    {
+        const std::string text = generator.Text(bytes);
+        std::fwrite(text.data(), 1, text.length(), stdout);
+    }
+    else
+        for (std::size_t i = 0; i < lines; i++)
+        {
+            const std::string line = generator.Line() + "\n";
+            std::fwrite(line.data(), 1, line.length(), stdout);
+        }
+
+    return 0;
+}
@@ -0,0 +1,26 @@
+#include <LibUwu.h>
+#include "Corpus.h"
+#include "Catch2.h"
+#include <string>
+#include <vector>
+
+// Runs every rule of MakeUwu on its own, so that we know what each of them costs.
+// Every rule gets fed what all rules before it produced, just like within MakeUwu.
+TEST_CASE(__FILE__"/PerRule", "[benchmark]")
+{
+    for (const std::size_t size : { 1 << 10, 1 << 16, 1 << 20 })
+    {
+        std::string text = CorpusGenerator({ .seed = 42 }).Text(size);
+
+        for (const UwuRule& rule : UwuRules())
+        {
+            const Cascade cascade = Cascade().Then(rule.stage);
+
+            BENCHMARK(std::string(rule.name) + ", " + std::to_string(size >> 10) + " KiB") {
+                return cascade.Run(text, 42);
+            };
+
+            text = cascade.Run(text, 42);
+        }
+    }
+}
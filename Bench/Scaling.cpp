@@ -0,0 +1,185 @@
+#include "Scaling.h"
+#include "Corpus.h"
+#include <LibUwu.h>
+#include <Pipeline.h>
+#include <FileTransform.h>
+#include <WorkStealingPool.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <span>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    //! What a mode did on some number of threads
+    struct Result {
+        std::size_t bytes = 0;
+        double seconds = 0;
+        //! Of every unit of work: a call, a batch, or a whole run, depending on the mode
+        std::vector<double> latencies;
+    };
+
+    double Seconds(Clock::time_point since) {
+        return std::chrono::duration<double>(Clock::now() - since).count();
+    }
+
+    double Percentile(std::vector<double> values, double p) {
+        if (values.empty())
+            return 0;
+
+        const std::size_t index = std::min(values.size() - 1, static_cast<std::size_t>(p * values.size()));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+
+        return values[index];
+    }
+
+    //! Every thread calls MakeUwu on its own share of the lines
+    Result Independent(const std::vector<std::string>& lines, std::size_t threads, double minSeconds) {
+        std::vector<Result> perThread(threads);
+        const Clock::time_point start = Clock::now();
+
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < threads; t++)
+            workers.emplace_back([&, t]() {
+                Result& result = perThread[t];
+                std::string out;
+                do
+                {
+                    for (std::size_t i = t; i < lines.size(); i += threads)
+                    {
+                        const Clock::time_point begin = Clock::now();
+                        out.clear();
+                        MakeUwu(lines[i], out);
+                        result.latencies.push_back(Seconds(begin));
+                        result.bytes += lines[i].length();
+                    }
+                } while (Seconds(start) < minSeconds);
+            });
+
+        for (std::thread& worker : workers)
+            worker.join();
+
+        Result result;
+        result.seconds = Seconds(start);
+        for (const Result& r : perThread)
+        {
+            result.bytes += r.bytes;
+            result.latencies.insert(result.latencies.end(), r.latencies.begin(), r.latencies.end());
+        }
+
+        return result;
+    }
+
+    //! Runs `unit` over and over until at least `minSeconds` passed. Every run of it is `bytes` bytes of work
+    Result Repeat(const std::function<void()>& unit, std::size_t bytes, double minSeconds) {
+        Result result;
+        const Clock::time_point start = Clock::now();
+        do
+        {
+            const Clock::time_point begin = Clock::now();
+            unit();
+            result.latencies.push_back(Seconds(begin));
+            result.bytes += bytes;
+        } while (Seconds(start) < minSeconds);
+        result.seconds = Seconds(start);
+
+        return result;
+    }
+}
+
+int RunScaling(int argc, char** argv) {
+    std::size_t maxThreads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    double minSeconds = 1;
+    for (int i = 0; i + 1 < argc; i += 2)
+    {
+        if (std::strcmp(argv[i], "--max-threads") == 0)
+            maxThreads = std::max<std::size_t>(std::strtoull(argv[i + 1], nullptr, 10), 1);
+        else if (std::strcmp(argv[i], "--seconds") == 0)
+            minSeconds = std::strtod(argv[i + 1], nullptr);
+    }
+
+    // 1, 2, 4, ..., and the maximum itself
+    std::vector<std::size_t> threadCounts;
+    for (std::size_t threads = 1; threads < maxThreads; threads *= 2)
+        threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    // Chat lines, and the same lines as one file
+    const std::vector<std::string> lines = CorpusGenerator({ .seed = 1, .meanWordsPerLine = 8, .maxWordsPerLine = 60 }).Lines(20000);
+    std::string text;
+    for (const std::string& line : lines)
+        text += line + "\n";
+    const std::vector<std::string_view> views(lines.begin(), lines.end());
+
+    const std::string inPath = (std::filesystem::temp_directory_path() / "uwubench-scaling-in.txt").string();
+    const std::string outPath = (std::filesystem::temp_directory_path() / "uwubench-scaling-out.txt").string();
+    std::ofstream(inPath, std::ios::binary) << text;
+
+    const std::vector<std::pair<std::string, std::function<Result(std::size_t)>>> modes = {
+        // Independent calls, one thread each
+        { "independent", [&](std::size_t threads) {
+            return Independent(lines, threads, minSeconds);
+        } },
+        // MakeUwuBatch over all lines, on a pool of `threads`. A unit is a batch of 1000 lines
+        { "batch", [&](std::size_t threads) {
+            WorkStealingPool pool(threads);
+            std::vector<std::string> results(1000);
+            std::size_t next = 0;
+            return Repeat([&]() {
+                const std::size_t begin = next;
+                next = (next + results.size()) % (lines.size() - results.size());
+                MakeUwuBatch(std::span(views).subspan(begin, results.size()), results, 0, pool);
+            }, text.length() * results.size() / lines.size(), minSeconds);
+        } },
+        // The -j N stdin mode. A unit is a whole run
+        { "pipeline", [&](std::size_t threads) {
+            return Repeat([&]() {
+                std::istringstream in(text);
+                std::ostringstream out;
+                Pipeline([](const std::string& line) { return MakeUwu(line); }, threads).Run(in, out);
+            }, text.length(), minSeconds);
+        } },
+        // The -i/-o file mode. A unit is a whole run
+        { "file", [&](std::size_t threads) {
+            WorkStealingPool pool(threads);
+            const FileTransform transform([](std::string_view line, std::string& out) { MakeUwu(line, out); }, pool, 1 << 16);
+            return Repeat([&]() { transform.Run(inPath, outPath); }, text.length(), minSeconds);
+        } }
+    };
+
+    std::printf("mode,threads,bytes,seconds,mbPerSecond,efficiency,p50Microseconds,p99Microseconds,p999Microseconds\n");
+    for (const auto& [name, mode] : modes)
+    {
+        double singleThreaded = 0;
+        for (const std::size_t threads : threadCounts)
+        {
+            const Result result = mode(threads);
+            const double mbPerSecond = static_cast<double>(result.bytes) / result.seconds / 1e6;
+            if (threads == 1)
+                singleThreaded = mbPerSecond;
+
+            std::printf("%s,%zu,%zu,%.6f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+                        name.c_str(), threads, result.bytes, result.seconds, mbPerSecond,
+                        mbPerSecond / (singleThreaded * static_cast<double>(threads)),
+                        Percentile(result.latencies, 0.5) * 1e6,
+                        Percentile(result.latencies, 0.99) * 1e6,
+                        Percentile(result.latencies, 0.999) * 1e6);
+            std::fflush(stdout);
+        }
+    }
+
+    std::filesystem::remove(inPath);
+    std::filesystem::remove(outPath);
+
+    return 0;
+}
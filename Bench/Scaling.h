@@ -0,0 +1,9 @@
+#ifndef UWWWU_SCALING_H
+#define UWWWU_SCALING_H
+
+//! Runs MakeUwu on 1, 2, 4, ... threads, in every parallel mode there is, and prints a CSV line per mode and thread count:
+//! throughput, efficiency (relative to one thread, per thread), and latency percentiles.
+//! Takes the arguments following "--scaling": [--max-threads N] [--seconds S]
+int RunScaling(int argc, char** argv);
+
+#endif //UWWWU_SCALING_H
@@ -0,0 +1,275 @@
+// Standalone throughput benchmark.
+// Runs MakeUwu and Util::ConditionalReplaceButKeepSigns over fixed, generated corpora, and prints the numbers as JSON.
+// Usage: UwuBench [--save baseline.json] [--compare baseline.json [--threshold percent]] [corpus...]
+//        (default corpora: all of chat, paragraphs, doc-1mb, doc-100mb, adversarial)
+//        --save writes the JSON to a file, too. --compare prints how every benchmark compares to the baseline file,
+//        and exits with 1, if any of them got significantly slower, by more than the threshold (default: 10%).
+//        Exits with 2 on bad input, such as a baseline without any of the benchmarks that ran.
+//        The JSON says which kernels ran. Set UWWWU_KERNELS=scalar|sse4.2|avx2|avx512bw to bench another level.
+//        UwuBench --scaling [--max-threads N] [--seconds S]    (prints CSV, see Scaling.h)
+
+#include <LibUwu.h>
+#include "Corpus.h"
+#include "Scaling.h"
+#include "Baseline.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+// Every allocation of the process gets counted
+namespace {
+    std::atomic<std::size_t> allocations{ 0 };
+
+    // Keeps the results from being optimized away
+    volatile std::size_t sink = 0;
+}
+
+// None of them are inlined (as the library ones wouldn't be), or GCC would pair the malloc() and free() inside with the new and delete outside, and warn of a mismatch
+[[gnu::noinline]] void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+[[gnu::noinline]] void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete[](void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+namespace {
+    //! A bunch of texts. Every one of them is one call.
+    struct Corpus {
+        std::string name;
+        std::vector<std::string> texts;
+        std::size_t bytes = 0;
+    };
+
+    Corpus MakeCorpus(const std::string& name) {
+        Corpus corpus{ .name = name, .texts = {}, .bytes = 0 };
+
+        if (name == "chat")
+            // Lots of short lines
+            corpus.texts = CorpusGenerator({ .seed = 1, .meanWordsPerLine = 8, .maxWordsPerLine = 60 }).Lines(20000);
+        else if (name == "paragraphs")
+            corpus.texts = CorpusGenerator({ .seed = 2, .meanWordsPerLine = 100 }).Lines(2000);
+        else if ((name == "doc-1mb") || (name == "doc-100mb"))
+            // Lines of all kinds of lengths, separated by newlines, cut to the exact size
+            corpus.texts.push_back(CorpusGenerator({ .seed = 3 }).Text((name == "doc-1mb") ? 1000000 : 100000000));
+        else if (name == "adversarial")
+            // Worst cases for the rules, 64 KiB each
+            for (CorpusGenerator::AdversarialInput& input : CorpusGenerator::Adversarial(1 << 16))
+                corpus.texts.push_back(std::move(input.text));
+
+        for (const std::string& text : corpus.texts)
+            corpus.bytes += text.length();
+
+        return corpus;
+    }
+
+    //! Peak resident set size of this process so far, in KiB
+    long PeakRssKiB() {
+#if defined(__APPLE__)
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss / 1024; // Bytes, on macOS
+#elif defined(__unix__)
+        rusage usage{};
+        getrusage(RUSAGE_SELF, &usage);
+        return usage.ru_maxrss;
+#else
+        return 0;
+#endif
+    }
+
+    //! Runs `function` over all texts of `corpus`, over and over, in a few samples of at least `minSeconds` each,
+    //! and appends the numbers to `json`
+    template<typename Function>
+    BenchmarkResult Measure(const std::string& name, const Corpus& corpus, Function function, std::string& json) {
+        using Clock = std::chrono::steady_clock;
+        constexpr double minSeconds = 0.1;
+
+        // Huge corpora take long enough per pass, so they get fewer samples
+        const std::size_t samples = (corpus.bytes < 10000000) ? 5 : 2;
+
+        // Warm up the caches and the per-thread buffers. Huge corpora warm up well enough on their own.
+        if (corpus.bytes < 10000000)
+            for (const std::string& text : corpus.texts)
+                sink = sink + function(text).length();
+
+        std::size_t passes = 0;
+        double seconds = 0;
+        std::vector<double> mbPerSecond;
+        const std::size_t allocationsBefore = allocations.load();
+        for (std::size_t sample = 0; sample < samples; sample++)
+        {
+            std::size_t samplePasses = 0;
+            double sampleSeconds = 0;
+            const Clock::time_point start = Clock::now();
+            do
+            {
+                for (const std::string& text : corpus.texts)
+                    sink = sink + function(text).length();
+
+                samplePasses++;
+                sampleSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+            } while (sampleSeconds < minSeconds);
+
+            passes += samplePasses;
+            seconds += sampleSeconds;
+            mbPerSecond.push_back(static_cast<double>(corpus.bytes) * static_cast<double>(samplePasses) / sampleSeconds / 1e6);
+        }
+        const std::size_t allocated = allocations.load() - allocationsBefore;
+
+        const double bytes = static_cast<double>(corpus.bytes) * static_cast<double>(passes);
+        const double calls = static_cast<double>(corpus.texts.size()) * static_cast<double>(passes);
+
+        BenchmarkResult result;
+        result.name = name + "/" + corpus.name;
+        result.samples = samples;
+        for (const double sample : mbPerSecond)
+            result.mbPerSecond += sample / static_cast<double>(samples);
+        for (const double sample : mbPerSecond)
+            result.mbPerSecondStddev += (sample - result.mbPerSecond) * (sample - result.mbPerSecond) / static_cast<double>(samples - 1);
+        result.mbPerSecondStddev = std::sqrt(result.mbPerSecondStddev);
+
+        char line[1024];
+        std::snprintf(line, sizeof(line),
+                      "%s\n    {\"name\": \"%s\", \"corpus\": \"%s\", \"bytes\": %zu, \"calls\": %zu, \"passes\": %zu, \"seconds\": %.6f, "
+                      "\"samples\": %zu, \"mbPerSecond\": %.3f, \"mbPerSecondStddev\": %.3f, \"nsPerByte\": %.4f, \"allocationsPerCall\": %.3f, \"peakRssKiB\": %ld}",
+                      (json.back() == '[') ? "" : ",",
+                      result.name.c_str(), corpus.name.c_str(), corpus.bytes, corpus.texts.size(), passes, seconds,
+                      samples, result.mbPerSecond, result.mbPerSecondStddev, seconds * 1e9 / bytes, static_cast<double>(allocated) / calls, PeakRssKiB());
+        json += line;
+
+        // Show progress, for the long runs
+        std::fprintf(stderr, "%s: %.3f MB/s\n", result.name.c_str(), result.mbPerSecond);
+
+        return result;
+    }
+}
+
+int main(int argc, char** argv) {
+    if ((argc > 1) && (std::string(argv[1]) == "--scaling"))
+        return RunScaling(argc - 2, argv + 2);
+
+    std::vector<std::string> corpusNames;
+    std::string savePath;
+    std::string comparePath;
+    double thresholdPercent = 10;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if ((arg == "--save") && (i + 1 < argc))
+            savePath = argv[++i];
+        else if ((arg == "--compare") && (i + 1 < argc))
+            comparePath = argv[++i];
+        else if ((arg == "--threshold") && (i + 1 < argc))
+        {
+            // A typo must not turn into a threshold of 0%
+            const char* value = argv[++i];
+            char* end = nullptr;
+            thresholdPercent = std::strtod(value, &end);
+            if ((end == value) || (*end != '\0') || (!std::isfinite(thresholdPercent)) || (thresholdPercent < 0))
+            {
+                std::fprintf(stderr, "--threshold: Expected a percentage of 0 or more, got %s\n", value);
+                return 2;
+            }
+        }
+        else
+            corpusNames.push_back(arg);
+    }
+    if (corpusNames.empty())
+        corpusNames = { "chat", "paragraphs", "doc-1mb", "doc-100mb", "adversarial" };
+
+    // Fail early, not after minutes of benchmarking
+    std::vector<BenchmarkResult> baseline;
+    if (!comparePath.empty())
+    {
+        try
+        {
+            baseline = LoadBaseline(comparePath);
+        }
+        catch (const std::runtime_error& e)
+        {
+            std::fprintf(stderr, "%s\n", e.what());
+            return 2;
+        }
+    }
+
+    std::string json = "{\n  \"benchmarks\": [";
+    std::vector<BenchmarkResult> results;
+
+    for (const std::string& corpusName : corpusNames)
+    {
+        const Corpus corpus = MakeCorpus(corpusName);
+        if (corpus.texts.empty())
+        {
+            std::fprintf(stderr, "Unknown corpus: %s\n", corpusName.c_str());
+            return 2;
+        }
+
+        results.push_back(Measure("MakeUwu", corpus, [](const std::string& text) {
+            return MakeUwu(text);
+        }, json));
+
+        results.push_back(Measure("ConditionalReplaceButKeepSigns", corpus, [](const std::string& text) {
+            return Util::ConditionalReplaceButKeepSigns(text, "th", "tw");
+        }, json));
+    }
+
+    json += "\n  ],\n  \"kernels\": \"" + std::string(Kernels::LevelName(Kernels::ActiveLevel())) + "\",";
+    json += "\n  \"peakRssKiB\": " + std::to_string(PeakRssKiB()) + "\n}\n";
+    std::fputs(json.c_str(), stdout);
+
+    if (!savePath.empty())
+        std::ofstream(savePath) << json;
+
+    // Exit with 1 if anything got significantly slower
+    if (!comparePath.empty())
+    {
+        try
+        {
+            return CompareToBaseline(baseline, results, thresholdPercent) ? 1 : 0;
+        }
+        catch (const std::runtime_error& e)
+        {
+            std::fprintf(stderr, "%s\n", e.what());
+            return 2;
+        }
+    }
+
+    return 0;
+}
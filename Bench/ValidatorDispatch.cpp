@@ -0,0 +1,59 @@
+#include <LibUwu.h>
+#include "Catch2.h"
+
+namespace {
+    // Plenty of findings for the callbacks to decide on
+    std::string MakeText(const std::size_t length) {
+        const std::string sentence = "None of the nine nannies ever knew when the next one would run in. ";
+
+        std::string text;
+        while (text.length() < length)
+            text += sentence;
+
+        return text;
+    }
+
+    // The 'n'-rule of MakeUwu, boiled down
+    bool NextIsVowel(const std::string& original, const std::string& finding, const std::size_t index) {
+        if (index + finding.length() == original.length())
+            return false;
+
+        return CharTools::IsVowel(original[index + finding.length()]);
+    }
+}
+
+// Compares calling a callback through a std::function with having it inlined into the scan
+TEST_CASE(__FILE__"/ValidatorDispatch", "[benchmark]")
+{
+    const std::string text = MakeText(1 << 20);
+    const std::function<bool(const std::string&, const std::string&, const std::size_t)> asFunction = NextIsVowel;
+    const auto asLambda = [](const std::string& original, const std::string& finding, const std::size_t index) {
+        return NextIsVowel(original, finding, index);
+    };
+
+    // Both have to agree, or there is nothing to compare
+    REQUIRE(Util::ConditionalReplaceButKeepSigns(text, "n", "ny", asFunction) == Util::ConditionalReplaceButKeepSigns(text, "n", "ny", asLambda));
+
+    BENCHMARK("n-rule, std::function, 1 MiB") {
+        return Util::ConditionalReplaceButKeepSigns(text, "n", "ny", asFunction);
+    };
+
+    BENCHMARK("n-rule, template, 1 MiB") {
+        return Util::ConditionalReplaceButKeepSigns(text, "n", "ny", asLambda);
+    };
+
+    // Same, but asking a Finding about the next char, which is a bit test into the classified text
+    BENCHMARK("n-rule, Finding, 1 MiB") {
+        return Util::ConditionalReplaceButKeepSigns(text, "n", "ny", [](const Util::Finding& finding) {
+            return finding.IsVowel(finding.Next());
+        });
+    };
+
+    BENCHMARK("complete-word, std::function, 1 MiB") {
+        return Util::ConditionalReplaceButKeepSigns(text, "nine", "ten", std::function<bool(const std::string&, const std::string&, const std::size_t)>(ValidatorFindingIsCompleteWord));
+    };
+
+    BENCHMARK("complete-word, template, 1 MiB") {
+        return Util::ConditionalReplaceButKeepSigns(text, "nine", "ten", ValidatorFindingIsCompleteWord);
+    };
+}
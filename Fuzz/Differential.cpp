@@ -0,0 +1,163 @@
+#include "Differential.h"
+#include "Reference.h"
+#include <LibUwu.h>
+#include <StringTools.h>
+#include <algorithm>
+#include <vector>
+
+namespace {
+    // Callbacks looking at the surrounding chars, just like the rules' do
+    bool NextIsVowel(const std::string& original, const std::string& finding, const std::size_t index) {
+        if (index + finding.length() == original.length())
+            return false;
+
+        return CharTools::IsVowel(CharTools::MakeLower(original[index + finding.length()]));
+    }
+
+    bool AtWordEnd(const std::string& original, const std::string& finding, const std::size_t index) {
+        if (index + finding.length() == original.length())
+            return true;
+
+        return !CharTools::IsLetter(original[index + finding.length()]);
+    }
+
+    bool AfterLetter(const std::string& original, const std::string&, const std::size_t index) {
+        return (index > 0) && (CharTools::IsLetter(original[index - 1]));
+    }
+
+    std::string Escape(const std::string& str) {
+        std::string escaped = "\"";
+        for (const char c : str)
+        {
+            const unsigned char u = (unsigned char)c;
+            if ((c == '"') || (c == '\\'))
+                escaped += std::string("\\") + c;
+            else if ((u >= 0x20) && (u < 0x7F))
+                escaped += c;
+            else
+            {
+                // Octal, because a hex escape would swallow any hex digits following it
+                char octal[5];
+                std::snprintf(octal, sizeof(octal), "\\%03o", u);
+                escaped += octal;
+            }
+        }
+
+        return escaped + "\"";
+    }
+}
+
+std::optional<Differential::Mismatch> Differential::Check(std::string_view data)
+{
+    const std::uint64_t seed = data.empty() ? 0 : (unsigned char)data[0];
+    const std::string text(data.empty() ? data : data.substr(1));
+
+    const auto compare = [&](const std::string& what, const std::string& expected, const std::string& actual) -> std::optional<Mismatch> {
+        if (expected == actual)
+            return std::nullopt;
+
+        return Mismatch{ what, text, seed, expected, actual };
+    };
+
+    // The whole thing
+    if (auto mismatch = compare("MakeUwu", Reference::MakeUwu(text, seed), MakeUwu(text, seed)))
+        return mismatch;
+
+    // The rules, pushed through in tiny blocks, so that every block border gets hit
+    {
+        const std::size_t blockSize = 1 + text.length() % 7;
+        Cascade cascade(blockSize);
+        for (const UwuRule& rule : UwuRules())
+            cascade.Then(rule.stage);
+
+        const std::string what = "UwuRules() at block size " + std::to_string(blockSize);
+        if (auto mismatch = compare(what, Reference::MakeUwu(text, seed), cascade.Run(text, Util::Random(seed, Util::Hash(text)))))
+            return mismatch;
+    }
+
+    // The replace functions, with all kinds of findings and callbacks
+    struct Case {
+        const char* find;
+        const char* sub;
+        Util::Validator onlyIf;
+    };
+    const std::vector<Case> cases = {
+        { "th", "tw", [](const auto&, const auto&, auto) { return true; } },
+        { "n", "ny", NextIsVowel },
+        { "er", "a", AtWordEnd },
+        { "ll", "w", AfterLetter },
+        { "twank you", "you're twe best", ValidatorFindingIsCompleteWord },
+        { "aa", "aaaa", NextIsVowel }
+    };
+    for (const Case& c : cases)
+    {
+        const std::string what = std::string("ConditionalReplaceButKeepSigns(\"") + c.find + "\", \"" + c.sub + "\")";
+        if (auto mismatch = compare(what, Reference::ConditionalReplaceButKeepSigns(text, c.find, c.sub, c.onlyIf),
+                                    Util::ConditionalReplaceButKeepSigns(text, c.find, c.sub, c.onlyIf)))
+            return mismatch;
+    }
+
+    // MultiReplaceButKeepSigns has no baseline of its own. But for a table like the emoticons' (case-sensitive ones, that can't feed each other,
+    // and then one keeping signs, which none of them feeds), it has to come out just like the baseline's replacing one after the other
+    {
+        std::string expected = StringTools::Replace(text, ":)", "UwU");
+        expected = StringTools::Replace(expected, ":-)", "UwwwU");
+        expected = Reference::ConditionalReplaceButKeepSigns(expected, "c++", "c++ (rust)");
+
+        const Util::ReplacementTable table = {
+            { ":)", "UwU", nullptr, false },
+            { ":-)", "UwwwU", nullptr, false },
+            { "c++", "c++ (rust)" }
+        };
+
+        if (auto mismatch = compare("MultiReplaceButKeepSigns", expected, Util::MultiReplaceButKeepSigns(text, table)))
+            return mismatch;
+    }
+
+    return std::nullopt;
+}
+
+std::string Differential::Minimise(std::string data)
+{
+    if (!Check(data))
+        return data;
+
+    // Try cutting out chunks, from big ones down to single bytes. The seed byte stays.
+    for (std::size_t chunk = std::max<std::size_t>(data.length() / 2, 1); chunk > 0; chunk /= 2)
+    {
+        for (std::size_t begin = 1; begin < data.length();)
+        {
+            std::string smaller = data;
+            smaller.erase(begin, chunk);
+
+            if (Check(smaller))
+                data = std::move(smaller);
+            else
+                begin += chunk;
+        }
+    }
+
+    // Try making the seed as boring as possible
+    if (!data.empty())
+    {
+        std::string boringSeed = data;
+        boringSeed[0] = 0;
+        if (Check(boringSeed))
+            data = std::move(boringSeed);
+    }
+
+    return data;
+}
+
+void Differential::Print(const Mismatch& mismatch, std::FILE* file)
+{
+    std::fprintf(file, "Mismatch in %s\n", mismatch.what.c_str());
+    std::fprintf(file, "  seed:      %llu\n", (unsigned long long)mismatch.seed);
+    std::fprintf(file, "  text:      %s\n", Escape(mismatch.text).c_str());
+    std::fprintf(file, "  reference: %s\n", Escape(mismatch.expected).c_str());
+    std::fprintf(file, "  engine:    %s\n", Escape(mismatch.actual).c_str());
+
+    // Where they part ways
+    const auto diff = std::mismatch(mismatch.expected.begin(), mismatch.expected.end(), mismatch.actual.begin(), mismatch.actual.end());
+    std::fprintf(file, "  first difference at byte %zu\n", (std::size_t)(diff.first - mismatch.expected.begin()));
+}
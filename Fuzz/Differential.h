@@ -0,0 +1,35 @@
+#ifndef UWWWU_DIFFERENTIAL_H
+#define UWWWU_DIFFERENTIAL_H
+
+#include <string>
+#include <string_view>
+#include <optional>
+#include <cstdio>
+#include <cstdint>
+
+//! Runs inputs through both the Reference and the real engine, and compares the bytes they produce.
+class Differential {
+public:
+    //! What came out different
+    struct Mismatch {
+        //! Which function, with which arguments
+        std::string what;
+        std::string text;
+        std::uint64_t seed;
+        std::string expected;
+        std::string actual;
+    };
+
+    //! Takes the first byte of `data` as seed, and the rest as text. Runs it through MakeUwu,
+    //! through its rules at an odd block size, and through the replace functions, with all kinds of callbacks.
+    //! Returns the first mismatch, if there is any.
+    static std::optional<Mismatch> Check(std::string_view data);
+
+    //! Shrinks `data` bit by bit, as long as Check() still finds a mismatch
+    static std::string Minimise(std::string data);
+
+    //! Prints `mismatch` to `file`, with the text as a C string literal, ready to be pasted into a test
+    static void Print(const Mismatch& mismatch, std::FILE* file);
+};
+
+#endif //UWWWU_DIFFERENTIAL_H
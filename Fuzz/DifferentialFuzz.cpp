@@ -0,0 +1,20 @@
+// libFuzzer target: Feeds arbitrary bytes to both the Reference and the real engine, and crashes on the first difference,
+// after printing a minimised reproducer. Build with UWWWU_FUZZ=ON, using clang.
+// Usage: UwuDiffFuzz [corpus dir] [libFuzzer options]
+
+#include "Differential.h"
+#include <cstdlib>
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    const std::string input(reinterpret_cast<const char*>(data), size);
+
+    if (const auto mismatch = Differential::Check(input))
+    {
+        const std::string minimised = Differential::Minimise(input);
+        Differential::Print(*Differential::Check(minimised), stderr);
+        std::abort();
+    }
+
+    return 0;
+}
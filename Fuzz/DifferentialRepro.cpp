@@ -0,0 +1,80 @@
+// Runs inputs through both the Reference and the real engine, without needing libFuzzer.
+// Prints a minimised reproducer for the first difference, and exits with 1.
+// Usage: UwuDiffRepro <file>...                    (e.g. crash files from UwuDiffFuzz)
+//        UwuDiffRepro --random <count> [seed]      (random bytes, and made-up English)
+
+#include "Differential.h"
+#include <Corpus.h>
+#include <Util.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace {
+    int Run(const std::vector<std::string>& inputs) {
+        for (const std::string& input : inputs)
+            if (Differential::Check(input))
+            {
+                Differential::Print(*Differential::Check(Differential::Minimise(input)), stdout);
+                return 1;
+            }
+
+        std::printf("%zu inputs, no differences\n", inputs.size());
+        return 0;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> inputs;
+
+    if ((argc > 2) && (std::strcmp(argv[1], "--random") == 0))
+    {
+        const std::size_t count = std::strtoull(argv[2], nullptr, 10);
+        const std::uint64_t seed = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 0;
+
+        CorpusGenerator generator({ .seed = seed, .triggerDensity = 0.7, .punctuationDensity = 0.3, .emoticonDensity = 0.1 });
+        std::uint64_t counter = 0;
+        for (std::size_t i = 0; i < count; i++)
+        {
+            // Every other one is random bytes, leaning towards the chars the rules care about
+            if (i % 2 == 0)
+            {
+                inputs.push_back(std::string(1, (char)i) + generator.Line());
+                continue;
+            }
+
+            const std::string alphabet = "thnrcllyeraoiuTHNRY :)-(^^D+c.,!?\n\t\x80\xff";
+            std::string input;
+            const std::size_t length = Util::Random(seed, counter++) % 64;
+            for (std::size_t j = 0; j < length; j++)
+            {
+                const std::uint64_t roll = Util::Random(seed, counter++);
+                input += (roll % 4 == 0) ? (char)(roll >> 8) : alphabet[(roll >> 8) % alphabet.length()];
+            }
+            inputs.push_back(input);
+        }
+    }
+    else if (argc > 1)
+        for (int i = 1; i < argc; i++)
+        {
+            std::ifstream file(argv[i], std::ios::binary);
+            if (!file)
+            {
+                std::fprintf(stderr, "Can't open %s\n", argv[i]);
+                return 2;
+            }
+
+            std::stringstream ss;
+            ss << file.rdbuf();
+            inputs.push_back(ss.str());
+        }
+    else
+    {
+        std::fprintf(stderr, "Usage: UwuDiffRepro <file>... | --random <count> [seed]\n");
+        return 2;
+    }
+
+    return Run(inputs);
+}
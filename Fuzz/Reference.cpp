@@ -0,0 +1,483 @@
+#include "Reference.h"
+#include <StringTools.h>
+#include <CharTools.h>
+#include <sstream>
+
+std::uint64_t Reference::Hash(std::string_view str)
+{
+    // 64-bit FNV-1a
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (const char c : str)
+    {
+        hash ^= (unsigned char)c;
+        hash *= 0x100000001B3ull;
+    }
+
+    return hash;
+}
+
+std::uint64_t Reference::Random(std::uint64_t key, std::uint64_t counter)
+{
+    // SplitMix64's finalizer, over a Weyl sequence
+    const auto mix = [](std::uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    };
+
+    return mix(mix(key) + (counter + 1) * 0x9E3779B97F4A7C15ull);
+}
+
+std::string Reference::ConditionalReplaceButKeepSigns(
+        const std::string& str,
+        std::string find,
+        const std::string& sub,
+        const Validator& onlyIf
+)
+{
+
+    // Quick accepts-and rejects
+    if (str.length() == 0)
+        return "";
+    else if (find.length() == 0)
+        return str;
+
+    std::stringstream ss;
+
+    // Better safe than sorry
+    find = StringTools::Lower(find);
+
+    for (std::size_t i = 0; i < str.length(); i++)
+    {
+        const std::string foundInText = str.substr(i, find.length());
+        const std::string foundInText_lower = StringTools::Lower(foundInText);
+        if (foundInText_lower == find)
+        {
+            // Ask the callback if we should replace this one
+            if (onlyIf(str, foundInText, i))
+            {
+                // Here we've found our occurrence...
+                // We have three possible cases:
+                // 1: len(find) == len(sub), in this case we want to sync capitalization by index.
+                // 2: len(find) < len(sub), in this case we sync by index, BUT...
+                // 3: len(find) > len(sub): sync capitalization by index
+
+                // We want to sync capitalization by index
+                // This accounts for both cases: 1 and 3
+                if (foundInText.length() >= sub.length())
+                {
+                    for (std::size_t j = 0; j < sub.length(); j++)
+                    {
+                        const char cf = foundInText[j];
+                        const char cs = sub[j];
+
+                        ss << CharTools::CopySign(cf, cs);
+                    }
+                }
+
+                    // in this case we sync by index, BUT...
+                else if (foundInText.length() < sub.length())
+                {
+                    char followingCharsSign = 0;
+                    bool doHaveFollowingChar = false;
+                    // Do we even have a following char?
+                    if (str.length() >= i + foundInText.length() + 1)
+                    {
+                        const char followingChar = str[i + foundInText.length()];
+
+                        // Is it a letter?
+                        if (CharTools::IsLetter(followingChar))
+                        {
+                            // Copy its sign
+                            followingCharsSign = followingChar;
+                            doHaveFollowingChar = true;
+                        }
+                    }
+
+
+                    char lastCharCharSign = 0;
+                    for (std::size_t j = 0; j < sub.length(); j++)
+                    {
+                        const char cs = sub[j];
+
+                        // Do we still have chars of 'find' left?
+                        if (j < foundInText.length())
+                        {
+                            // Yes: Just copy the sign as is, and update the last sign seen
+                            const char cf = foundInText[j];
+                            lastCharCharSign = cf;
+                            ss << CharTools::CopySign(cf, cs);
+                        }
+                        else
+                        {
+                            // No: Use the last sign seen, or the sign of the following char (the following char within the same word-boundary) (Important for replacing vocals within a word)
+                            const char charSignToUse = doHaveFollowingChar ? followingCharsSign : lastCharCharSign;
+                            ss << CharTools::CopySign(charSignToUse, cs);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                // We do not have an occurrence... just insert the subsection found as is (next iteration will start behind it)
+                ss << foundInText;
+            }
+
+            // Advance i accordingly
+            i += foundInText.length()-1;
+        }
+        else
+        {
+            // We do not have an occurrence... just insert the char as is
+            ss << str[i];
+        }
+    }
+
+    return ss.str();
+}
+
+namespace {
+    // This validator will only replace findings, if they are a complete word, and not just part of a word.
+    auto ValidatorFindingIsCompleteWord(const std::string& original, const std::string& finding, const std::size_t index) -> bool {
+        // Quick-accept: Original-string length matches finding-string length
+        if (original.length() == finding.length())
+            return true;
+
+        bool lastCharBreaksWord = true; // Default is true, because this value stays in case there is no last/next char.
+        bool nextCharBreaksWord = true; // In this case, "no character" would imply the word to be broken.
+
+        // Assign surrounding chars, if possible
+        if (index > 0)
+            lastCharBreaksWord = !CharTools::IsLetter(original[index - 1]);
+        if (index + finding.length() < original.length())
+            nextCharBreaksWord = !CharTools::IsLetter(original[index + finding.length()]);
+
+        // If both the last and the next character are word-breaking, replace.
+        if (lastCharBreaksWord && nextCharBreaksWord)
+            return true;
+            // Else: don't
+        else
+            return false;
+    }
+}
+
+std::string Reference::MakeUwu(std::string boringString, std::uint64_t seed)
+{
+    // Every roll of the dice is derived from this
+    const std::uint64_t key = Random(seed, Hash(boringString));
+
+    // Easy ones first
+    // none, lol
+
+    // Slightly more complex... Multichar replacements, but we have to keep capitalization...
+    boringString = ConditionalReplaceButKeepSigns(boringString, "th", "tw");
+    boringString = ConditionalReplaceButKeepSigns(boringString, "ove", "uv");
+    boringString = ConditionalReplaceButKeepSigns(boringString, "have", "haf");
+    boringString = ConditionalReplaceButKeepSigns(boringString, "tr", "tw");
+    boringString = ConditionalReplaceButKeepSigns(boringString, "up", "uwp");
+
+    // Let's do some language adjustments
+    boringString = ConditionalReplaceButKeepSigns(boringString, "twank you", "you're twe best <3333 xoxo", ValidatorFindingIsCompleteWord);
+    boringString = ConditionalReplaceButKeepSigns(boringString, "good", "sooper dooper", ValidatorFindingIsCompleteWord);
+    boringString = ConditionalReplaceButKeepSigns(boringString, "suwper", "sooper dooper", ValidatorFindingIsCompleteWord);
+    boringString = ConditionalReplaceButKeepSigns(boringString, "well", "sooper dooper", ValidatorFindingIsCompleteWord);
+    boringString = ConditionalReplaceButKeepSigns(boringString, "emacs", "vim", ValidatorFindingIsCompleteWord);
+    boringString = ConditionalReplaceButKeepSigns(boringString, "twanks", "you're twe best :33 xoxo", ValidatorFindingIsCompleteWord);
+    boringString = ConditionalReplaceButKeepSigns(boringString, "hello", "hiiiiiii", ValidatorFindingIsCompleteWord);
+    boringString = ConditionalReplaceButKeepSigns(boringString, "dear", "hiiiiiii", ValidatorFindingIsCompleteWord);
+
+    // Let's extend some phonetics
+    boringString = ConditionalReplaceButKeepSigns(boringString, "hi", "hiiiiiii");
+    boringString = ConditionalReplaceButKeepSigns(boringString, "ay", "aaay");
+    boringString = ConditionalReplaceButKeepSigns(boringString, "ey", "eeey");
+
+    // Replace N with Ny, but only if succeeded by a vowel, and not (preceded by an o and succeeded by an "e{nonletter}"): "one" has such a niche pronunciation...
+    boringString = ConditionalReplaceButKeepSigns(
+            boringString,
+            "n",
+            "ny",
+            [](const std::string& original, const std::string& finding, const std::size_t index) {
+                // Don't replace, if we are on the last char
+                if (index + finding.length() == original.length())
+                    return false;
+
+                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
+                const bool haveLastchar = index > 0; // Do we even have a last char?
+                const char lastChar = haveLastchar ? CharTools::MakeLower(original[index - 1]) : '\0';
+
+                // Apply the complex "one\b"-rule:
+                // (don't replace if 'n' is preceded by 'o' and succeeded by 'e', which is succeeded by a word break)
+                {
+                    bool nextNextCharIsNotLetter = false;
+                    char nextNextChar;
+
+                    // How much length is left including `nextChar`?
+                    const std::size_t sizeLeft = original.length() - (index + finding.length());
+
+                    // We have room to pick the nextNext char...
+                    if (sizeLeft > 1)
+                    {
+                        nextNextChar = CharTools::MakeLower(original[index + finding.length() + 1]);
+                        nextNextCharIsNotLetter = !CharTools::IsLetter(nextNextChar);
+                    }
+
+                    const bool nextNextCharBreaksWord = (sizeLeft == 1) || (nextNextCharIsNotLetter);
+
+                    // Don't replace if:
+                    // (lastChar == o) && (nextChar == e) && (nextNextCharBreaksWord)
+                    if ((haveLastchar) && (lastChar == 'o') && (nextChar == 'e') && (nextNextCharBreaksWord))
+                        return false;
+                }
+
+                // Is this a vowel?
+                if (CharTools::IsVowel(nextChar))
+                    return true;
+
+                // Else, don't replace
+                return false;
+            }
+    );
+
+    // Replace R with W, but only if not succeeded by a non-vowel, and if it's not the first character of a word
+    boringString = ConditionalReplaceButKeepSigns(
+            boringString,
+            "r",
+            "w",
+            [](const std::string& original, const std::string& finding, const std::size_t index) {
+                // Don't replace, if we are on the last char
+                if (index + finding.length() == original.length())
+                    return false;
+
+                // Don't replace if we're at index 0
+                if (index == 0)
+                    return false;
+
+                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
+                const char lastChar = CharTools::MakeLower(original[index - 1]);
+
+                // Is this a non-vowel?
+                if (!CharTools::IsVowel(nextChar))
+                    return false;
+
+                // Don't replace if the last char is not a letter
+                if (!CharTools::IsLetter(lastChar))
+                    return false;
+
+                // Else, replace
+                return true;
+            }
+    );
+
+    // Replace C with W, but only if succeeded and preceeded by a vowel
+    boringString = ConditionalReplaceButKeepSigns(
+            boringString,
+            "c",
+            "w",
+            [](const std::string& original, const std::string& finding, const std::size_t index) {
+                // Don't replace, if we are on the last char
+                if (index + finding.length() == original.length())
+                    return false;
+
+                // Don't replace if we're at index 0
+                if (index == 0)
+                    return false;
+
+                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
+                const char lastChar = CharTools::MakeLower(original[index - 1]);
+
+                // Don't replace, if the next char is not a vowel
+                if (!CharTools::IsVowel(nextChar))
+                    return false;
+
+                // Don't replace if the last char is not a vowel
+                if (!CharTools::IsVowel(lastChar))
+                    return false;
+
+                // Else, replace
+                return true;
+            }
+    );
+
+    // Replace L with W, but only if not followed or preceded by another L, and if it's not the first character of a word
+    boringString = ConditionalReplaceButKeepSigns(
+            boringString,
+            "l",
+            "w",
+            [](const std::string& original, const std::string& finding, const std::size_t index) {
+                // Our segment has to be at least two characters long
+                if (original.length() < finding.length() + 2)
+                    return false;
+
+                // Don't replace if we're at index o
+                if (index == 0)
+                    return false;
+
+                const char lastChar = CharTools::MakeLower(original[index - 1]);
+                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
+
+                // Don't replace if the last char is not a letter
+                if (!CharTools::IsLetter(lastChar))
+                    return false;
+
+                return (lastChar != 'l') && (nextChar != 'l');
+            }
+    );
+
+    // Replace LL with WW, but only if followed by a vowel
+    boringString = ConditionalReplaceButKeepSigns(
+            boringString,
+            "ll",
+            "ww",
+            [](const std::string& original, const std::string& finding, const std::size_t index) {
+                // Don't replace, if we are on the last char
+                if (index + finding.length() == original.length())
+                    return false;
+
+                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
+
+                return CharTools::IsVowel(nextChar);
+            }
+    );
+
+    // Replace ER with A, but only if it's the last two letters of a word
+    boringString = ConditionalReplaceButKeepSigns(
+            boringString,
+            "er",
+            "a",
+            [](const std::string& original, const std::string& finding, const std::size_t index) {
+                // Replace if we're at the end of this line/segment
+                if (index + finding.length() == original.length())
+                    return true;
+
+                // Fetch the next char
+                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
+
+                // Replace if the next char is not a letter
+                return !CharTools::IsLetter(nextChar);
+            }
+    );
+
+    // Replace R with W, but only (if it's preceeded by a vowel,
+    // or preceeded by another 'r',
+    // or if it's the first character of a word)
+    // and if it's not the last character of a word
+    boringString = ConditionalReplaceButKeepSigns(
+            boringString,
+            "r",
+            "w",
+            [](const std::string& original, const std::string& finding, const std::size_t index) {
+                // Don't replace if it's the last character
+                if (index + finding.length() == original.length())
+                    return false;
+
+                // Do blindly replace if it's the first character
+                if (index == 0)
+                    return true;
+
+                // Fetch the last character
+                const char lastChar = CharTools::MakeLower(original[index - 1]);
+
+                // Fetch the next char
+                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
+
+                // Don't replace, if the last char is not a letter
+                if (!CharTools::IsLetter(lastChar))
+                  return false;
+
+                // Don't replace, if the next char is not a letter
+                if (!CharTools::IsLetter(nextChar))
+                  return false;
+
+                // Replace, if the last character is an 'r' aswell
+                if (lastChar == 'r')
+                  return true;
+
+                // Replace, if the last character is a vowel.
+                return CharTools::IsVowel(lastChar);
+            }
+    );
+
+    // Replace y with y-y (imitates shy stuttering), but only sometimes (random change),
+    // and if it is the first character of a word,
+    // and if it is followed by a vowel
+    boringString = ConditionalReplaceButKeepSigns(
+            boringString,
+            "y",
+            "y-y",
+            [key](const std::string& original, const std::string& finding, const std::size_t index) {
+                // Don't replace, if we're at the end of our string
+                if (index + finding.length() == original.length())
+                    return false;
+
+                // This is a bit tricky, because we can't abort if we're on the first char
+                // but we can can't not check the previous char either. Running big risk
+                // of causing a segfault. So we have to not check the previous character,
+                // if we are on the first char.
+
+                // Are we on the first char?
+                const bool isFirstChar = index == 0;
+
+                // Fetch the last character
+                const char lastChar = isFirstChar ? '\0' : CharTools::MakeLower(original[index - 1]);
+
+                // Fetch the next character
+                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
+
+                // Don't replace, if the last char is a letter
+                if ((!isFirstChar) && (CharTools::IsLetter(lastChar)))
+                    return false;
+
+                // Don't replace, if the next char is not a vowel
+                if (!CharTools::IsVowel(nextChar))
+                    return false;
+
+                // Chance (out of a 100) for the mutation to take place
+                // if all preconditions are met
+                constexpr int chance = 40;
+
+                // Roll the dice, baby!
+                return (Random(key, index) % 100) < chance;
+            }
+    );
+
+    // Replace random punctuation with uwwwwu cute symbols
+    // About evewy fifteenth symbol
+    std::stringstream ss;
+    for (std::size_t pos = 0; pos < boringString.length(); pos++)
+    {
+        const char c = boringString[pos];
+        const auto rng = [key, pos]() { return Random(key + 1, pos); };
+
+        if ((c == '.') && (rng() % 15 == 0))
+        {
+            ss << " <3333 ^.^ ";
+        }
+        else if ((c == '!') && (rng() % 15 == 0))
+        {
+            ss << "!! Thadws impowtant! <3 ";
+        }
+        else if ((c == ',') && (rng() % 15 == 0))
+        {
+            ss << " <3 aaaaaand ";
+        }
+        else if ((c == '?') && (rng() % 15 == 0))
+        {
+            ss << "?? now tell me! >:( ";
+        }
+        else
+            ss << c;
+    }
+    boringString = ss.str();
+
+    // Also replace some ascii-"emojis'
+    boringString = StringTools::Replace(boringString, ":)", "UwU :D");
+    boringString = StringTools::Replace(boringString, ":D", ":3");
+    boringString = StringTools::Replace(boringString, ":-)", "UwwwU :3");
+    boringString = StringTools::Replace(boringString, "^^", "^.^ UwU");
+
+    // Some language replacement should happen after these more complex rules
+    boringString = ConditionalReplaceButKeepSigns(boringString, "c++", "c++ (rust is hella cutewr btw ^^)");
+
+
+    return boringString;
+}
@@ -0,0 +1,38 @@
+#ifndef UWWWU_REFERENCE_H
+#define UWWWU_REFERENCE_H
+
+#include <string>
+#include <string_view>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+//! The baseline's MakeUwu and ConditionalReplaceButKeepSigns, frozen verbatim, as an oracle for the optimized engine.
+//! This is the plainest implementation possible: One full pass over the whole string per rule, one char at a time, just like it all started.
+//! It's slow, but obviously right. The fuzzer and the tests hold the real engine to producing exactly the same bytes.
+//! Only the dice got swapped: The baseline rolled them with std::mt19937, seeded by std::hash, which no two platforms (or, for the stutter, runs) agree on.
+//! Here, just like in the engine, every roll is Random(), keyed by the seed and the Hash() of the input, and counted by position.
+//! Don't touch this along with the engine. If the output of MakeUwu is supposed to change, change this on its own, saying why.
+class Reference {
+public:
+    using Validator = std::function<bool(const std::string&, const std::string&, const std::size_t)>;
+
+    //! Same as Util::ConditionalReplaceButKeepSigns
+    static std::string ConditionalReplaceButKeepSigns(
+            const std::string& str,
+            std::string find,
+            const std::string& sub,
+            const Validator& onlyIf = [](const auto&, const auto&, auto) { return true; }
+    );
+
+    //! Same as MakeUwu
+    static std::string MakeUwu(std::string boringString, std::uint64_t seed = 0);
+
+    //! Same as Util::Hash
+    static std::uint64_t Hash(std::string_view str);
+
+    //! Same as Util::Random
+    static std::uint64_t Random(std::uint64_t key, std::uint64_t counter);
+};
+
+#endif //UWWWU_REFERENCE_H
@@ -0,0 +1,113 @@
+#include "Cascade.h"
+#include <algorithm>
+
+Cascade::Cascade(std::size_t blockSize)
+    : blockSize(std::max<std::size_t>(blockSize, 1))
+{
+}
+
+Cascade& Cascade::Then(Stage stage)
+{
+    stages.emplace_back(std::move(stage));
+    return *this;
+}
+
+namespace {
+    //! Buffers a thread keeps around for running cascades
+    struct Workspace {
+        std::vector<std::string> buffers;
+        std::vector<std::size_t> positions;
+        std::vector<Cascade::RunInfo> runInfos;
+        bool inUse = false;
+    };
+
+    thread_local Workspace threadWorkspace;
+}
+
+std::string Cascade::Run(std::string_view input, std::uint64_t key) const
+{
+    std::string output;
+    output.reserve(input.length());
+
+    Run(input, output, key);
+
+    return output;
+}
+
+void Cascade::Run(std::string_view input, std::string& output, std::uint64_t key) const
+{
+    if (stages.empty())
+    {
+        output += input;
+        return;
+    }
+
+    // A stage running a cascade itself gets fresh buffers, instead of messing with ours
+    Workspace localWorkspace;
+    Workspace& workspace = threadWorkspace.inUse ? localWorkspace : threadWorkspace;
+    workspace.inUse = true;
+    struct Release {
+        Workspace& workspace;
+        ~Release() { workspace.inUse = false; }
+    } release{ workspace };
+
+    // Every stage gets its own input buffer, which only ever holds a block or so
+    std::vector<std::string>& buffers = workspace.buffers;
+    std::vector<std::size_t>& positions = workspace.positions;
+    std::vector<RunInfo>& runInfos = workspace.runInfos;
+    if (buffers.size() < stages.size())
+        buffers.resize(stages.size());
+    for (std::string& buffer : buffers)
+        buffer.clear();
+    positions.assign(stages.size(), 0);
+    runInfos.assign(stages.size(), RunInfo{ key, 0 });
+
+    std::size_t fed = 0;
+    bool final = false;
+    while (!final)
+    {
+        // Feed the next block to the first stage
+        const std::size_t blockLength = std::min(blockSize, input.length() - fed);
+        buffers[0].append(input, fed, blockLength);
+        fed += blockLength;
+        final = fed == input.length();
+
+        // ...and let it trickle down all the stages
+        for (std::size_t s = 0; s < stages.size(); s++)
+        {
+            std::string& out = (s + 1 < stages.size()) ? buffers[s + 1] : output;
+            positions[s] = stages[s](buffers[s], positions[s], final, out, runInfos[s]);
+
+            // Drop what this stage is done with, but keep a little bit of history
+            if ((!final) && (positions[s] >= blockSize + history))
+            {
+                buffers[s].erase(0, positions[s] - history);
+                runInfos[s].offset += positions[s] - history;
+                positions[s] = history;
+            }
+        }
+    }
+}
+
+Cascade::Stage Cascade::ReplaceButKeepSigns(
+        const std::string& find,
+        const std::string& sub,
+        const std::function<bool(const std::string&, const std::string&, const std::size_t)>& onlyIf
+)
+{
+    return ReplaceButKeepSigns<Util::Validator>(find, sub, onlyIf);
+}
+
+Cascade::Stage Cascade::MultiReplaceButKeepSigns(Util::ReplacementTable table)
+{
+    return [table = std::move(table)](const std::string& in, std::size_t pos, bool final, std::string& out, const RunInfo&) {
+        return Util::MultiReplaceButKeepSignsInto(in, pos, final, table, out);
+    };
+}
+
+Cascade::Stage Cascade::Replace(const std::string& find, const std::string& sub)
+{
+    return [find, sub](const std::string& in, std::size_t pos, bool final, std::string& out, const RunInfo&) {
+        return Util::ReplaceInto(in, pos, final, find, sub, out);
+    };
+}
@@ -0,0 +1,91 @@
+#ifndef UWWWU_CASCADE_H
+#define UWWWU_CASCADE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include "Util.h"
+
+//! Chains a bunch of replace-passes, so that they can be run over a text in one go, instead of one full pass per rule.
+//! Every pass only ever looks at a few chars around its current position, so the text gets pushed through
+//! all of them block by block. The intermediate results stay tiny (and in the cache),
+//! the input is only read once, and the output is only written once.
+class Cascade {
+public:
+    //! What a stage gets to know about the run it's part of.
+    struct RunInfo {
+        //! Key passed to Run(). Stages rolling dice should derive their rolls from it.
+        std::uint64_t key;
+        //! Position of `in[0]` within everything this stage has been fed during this run.
+        std::size_t offset;
+    };
+
+    //! A stage continues scanning its input `in` at `pos`, appends what it produced to `out`, and returns where to continue next time.
+    //! Unless `final` is set, more input might be appended, so it must stop early enough to keep the lookahead it needs.
+    //! It may look back at most `history` chars behind `pos`.
+    //! It has to get by with a constant amount of work per char it's fed, and produce at most a constant factor more than that.
+    //! As every stage only ever sees a block and a few chars of history, this keeps a whole run linear in the input's length.
+    using Stage = std::function<std::size_t(const std::string& in, std::size_t pos, bool final, std::string& out, const RunInfo& run)>;
+
+    explicit Cascade(std::size_t blockSize = 4096);
+
+    //! Appends a stage to this cascade. Stages are run in the order they were added.
+    Cascade& Then(Stage stage);
+
+    //! Will push `input` through all stages.
+    //! Produces the same as running all stages over the whole string, one after another.
+    //! Multiple threads may run the same cascade at once, as long as its stages don't share mutable state.
+    //! `key` gets passed on to the stages.
+    std::string Run(std::string_view input, std::uint64_t key = 0) const;
+
+    //! Same as above, but appends to `output`.
+    //! The stages' buffers get reused by later runs on the same thread, so this doesn't allocate anything but `output`, once warmed up.
+    void Run(std::string_view input, std::string& output, std::uint64_t key = 0) const;
+
+    //! Stage that does the same as Util::ConditionalReplaceButKeepSigns.
+    //! But the callback's string is the stage's buffer, not the whole input: The current block, and `history` chars before it.
+    //! That's the same, as long as the callback looks no further than Util::validatorLookbehind chars back, and Util::validatorLookahead ahead.
+    //! Its `index` counts from the start of the buffer, too. It's only 0 at the very start of the input, though.
+    static Stage ReplaceButKeepSigns(
+            const std::string& find,
+            const std::string& sub,
+            const std::function<bool(const std::string&, const std::string&, const std::size_t)>& onlyIf =
+                    [](const auto&, const auto&, auto) { return true; } // Default is: replace always
+    );
+
+    //! Same as above, but takes any callable as callback, instead of a std::function.
+    //! This way, the callback can be inlined into the stage's scan.
+    template<typename Callback>
+    static Stage ReplaceButKeepSigns(const std::string& find, const std::string& sub, Callback onlyIf);
+
+    //! Stage that does the same as Util::MultiReplaceButKeepSigns. Its callbacks get the stage's buffer, too.
+    static Stage MultiReplaceButKeepSigns(Util::ReplacementTable table);
+
+    //! Stage that does the same as StringTools::Replace.
+    static Stage Replace(const std::string& find, const std::string& sub);
+
+    //! How many chars before its current position a stage can still look at.
+    static constexpr std::size_t history = 8;
+
+private:
+    std::vector<Stage> stages;
+    std::size_t blockSize;
+};
+
+template<typename Callback>
+Cascade::Stage Cascade::ReplaceButKeepSigns(const std::string& find, const std::string& sub, Callback onlyIf)
+{
+    // Better safe than sorry
+    std::string lowerFind = find;
+    for (char& c : lowerFind)
+        c = CharTable::MakeLower(c);
+
+    return [find = std::move(lowerFind), sub, onlyIf = std::move(onlyIf)](const std::string& in, std::size_t pos, bool final, std::string& out, const RunInfo&) {
+        return Util::ConditionalReplaceButKeepSignsInto(in, pos, final, find, sub, onlyIf, out);
+    };
+}
+
+#endif //UWWWU_CASCADE_H
@@ -0,0 +1,90 @@
+#include "FileTransform.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+FileTransform::FileTransform(Transform transform, WorkStealingPool& pool, std::size_t chunkBytes, std::size_t windowBytes)
+    : transform(std::move(transform)),
+      pool(pool),
+      chunkBytes(std::max<std::size_t>(chunkBytes, 1)),
+      windowBytes(std::max<std::size_t>(windowBytes, 1))
+{
+}
+
+void FileTransform::Run(const std::string& inPath, const std::string& outPath) const
+{
+    const MappedFile in = MappedFile::Open(inPath);
+    const std::string_view text(in.Data(), in.Size());
+
+    // Emptying the output would empty the input, while it's still mapped (same device and inode, whatever the paths say)
+    std::error_code error;
+    if (std::filesystem::equivalent(inPath, outPath, error))
+        throw std::runtime_error("Can't write " + outPath + ", as it's the input file");
+
+    // Creates (or empties) the output file, before doing any of the work
+    MappedFile::Create(outPath, 0);
+
+    std::vector<std::string_view> chunks;
+    std::vector<std::string> outputs;
+    std::vector<std::size_t> offsets;
+    std::size_t written = 0;
+
+    for (std::size_t windowBegin = 0; windowBegin < text.length();)
+    {
+        // Cut the next window into chunks of whole lines
+        const std::size_t windowStart = windowBegin;
+        chunks.clear();
+        std::size_t begin = windowBegin;
+        while ((begin < text.length()) && (begin - windowBegin < windowBytes))
+        {
+            std::size_t end = text.find('\n', std::min(begin + chunkBytes, text.length()) - 1);
+            end = (end == std::string_view::npos) ? text.length() : end + 1;
+
+            chunks.push_back(text.substr(begin, end - begin));
+            begin = end;
+        }
+        windowBegin = begin;
+
+        // Transform every chunk on its own
+        outputs.resize(chunks.size());
+        pool.ForEach(chunks.size(), [&](std::size_t c) {
+            const std::string_view chunk = chunks[c];
+            std::string& out = outputs[c];
+            out.clear();
+            out.reserve(chunk.length() + chunk.length() / 4);
+
+            for (std::size_t begin = 0; begin < chunk.length();)
+            {
+                std::size_t end = chunk.find('\n', begin);
+                if (end == std::string_view::npos)
+                    end = chunk.length();
+
+                // Just like getline, a missing newline at the very end gets added
+                transform(chunk.substr(begin, end - begin), out);
+                out += '\n';
+
+                begin = end + 1;
+            }
+        });
+
+        // Every chunk goes where all chunks before it end
+        offsets.assign(chunks.size() + 1, 0);
+        for (std::size_t c = 0; c < chunks.size(); c++)
+            offsets[c + 1] = offsets[c] + outputs[c].length();
+
+        MappedFile out = MappedFile::Extend(outPath, written, offsets.back());
+        char* const data = out.Data();
+        pool.ForEach(chunks.size(), [&](std::size_t c) {
+            if (!outputs[c].empty())
+                std::memcpy(data + offsets[c], outputs[c].data(), outputs[c].length());
+        });
+
+        written += offsets.back();
+
+        // Done with this part of the input. Keeps the input's pages from adding up in memory, too
+        in.Release(windowStart, windowBegin - windowStart);
+    }
+}
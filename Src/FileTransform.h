@@ -0,0 +1,41 @@
+#ifndef UWWWU_FILETRANSFORM_H
+#define UWWWU_FILETRANSFORM_H
+
+#include <string>
+#include <string_view>
+#include <functional>
+#include <cstddef>
+#include "WorkStealingPool.h"
+
+//! Transforms a file line by line, on multiple threads, into another file, without any streams in between.
+//! The input gets mapped into memory, and cut into chunks of whole lines, and these into windows of chunks.
+//! Window by window, every chunk gets transformed on its own. Once the size of every chunk's output is known,
+//! the output file grows by the window's size, just that part gets mapped, and every chunk gets copied straight to its offset
+//! (the sum of the sizes of all chunks before it). So there's never more than a window of output in memory, no matter how big the file is.
+class FileTransform {
+public:
+    //! Appends the transformed version of `line` to `out`
+    using Transform = std::function<void(std::string_view line, std::string& out)>;
+
+    //! `transform` has to be safe to call from all threads of `pool` at once.
+    //! A chunk is cut at the first newline after `chunkBytes` bytes, a window after the first chunk that reaches `windowBytes` bytes.
+    explicit FileTransform(
+            Transform transform,
+            WorkStealingPool& pool = WorkStealingPool::Shared(),
+            std::size_t chunkBytes = 1 << 20,
+            std::size_t windowBytes = 64 << 20
+    );
+
+    //! Will write the transformed version of every line of `inPath` to `outPath`, each terminated by a newline.
+    //! Same output as Pipeline would write, and the same as calling `transform` on every line in order.
+    //! Throws std::runtime_error if either file can't be opened, if `inPath` isn't a regular file, or if both are the same file.
+    void Run(const std::string& inPath, const std::string& outPath) const;
+
+private:
+    Transform transform;
+    WorkStealingPool& pool;
+    std::size_t chunkBytes;
+    std::size_t windowBytes;
+};
+
+#endif //UWWWU_FILETRANSFORM_H
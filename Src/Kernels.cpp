@@ -0,0 +1,681 @@
+#include "Kernels.h"
+#include "CharTable.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+
+#if (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))) || defined(_M_X64)
+#include <immintrin.h>
+#define UWWWU_KERNELS_X86
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC hands out every instruction set's intrinsics anyway
+#define UWWWU_TARGET(isa)
+#else
+#include <cpuid.h>
+//! Compiles a function for `isa`, whatever the rest gets compiled for. Whether it gets to run is up to the CPU
+#define UWWWU_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace {
+    //! Whether `text` could start with `lowerFind` at `i`. Plain version of what the vectors do
+    bool IsCandidate(std::string_view text, std::size_t i, char firstLower, char firstUpper, bool checkSecond, char secondLower, char secondUpper) {
+        if ((text[i] != firstLower) && (text[i] != firstUpper))
+            return false;
+
+        if (!checkSecond)
+            return true;
+
+        // A finding of two or more chars can't start on the last one
+        return (i + 1 < text.length()) && ((text[i + 1] == secondLower) || (text[i + 1] == secondUpper));
+    }
+
+    //! Bit twiddling on 8 chars at once. Every function answers per byte, with the byte's 0x80 bit, and never carries into the next byte.
+    namespace Swar {
+        constexpr std::uint64_t ones = 0x0101010101010101ull;
+        constexpr std::uint64_t highBits = 0x8080808080808080ull;
+        constexpr std::uint64_t lowBits = 0x7F7F7F7F7F7F7F7Full;
+
+        //! 8 chars, the first one in the lowest byte
+        std::uint64_t Load(const char* chars) {
+            std::uint64_t v;
+            std::memcpy(&v, chars, sizeof(v));
+
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                std::uint64_t swapped = 0;
+                for (int b = 0; b < 8; b++)
+                    swapped |= ((v >> (8 * b)) & 0xFF) << (8 * (7 - b));
+                v = swapped;
+            }
+
+            return v;
+        }
+
+        //! Bytes that are 0
+        std::uint64_t ZeroBytes(std::uint64_t v) {
+            return ~(((v & lowBits) + lowBits) | v | lowBits);
+        }
+
+        //! Bytes that are `c`
+        std::uint64_t EqualBytes(std::uint64_t v, char c) {
+            return ZeroBytes(v ^ (ones * static_cast<std::uint8_t>(c)));
+        }
+
+        //! Bytes within [lowest, highest]. Both have to be within [1, 0x7F]
+        std::uint64_t BytesInRange(std::uint64_t v, char lowest, char highest) {
+            const std::uint64_t low = v & lowBits;
+            const std::uint64_t atLeastLowest = low + ones * static_cast<std::uint8_t>(0x80 - lowest);
+            const std::uint64_t aboveHighest = low + ones * static_cast<std::uint8_t>(0x7F - highest);
+
+            return atLeastLowest & ~aboveHighest & ~v & highBits;
+        }
+
+        //! All 8 chars in lowercase
+        std::uint64_t MakeLower(std::uint64_t v) {
+            // Moves the 0x80 bits of the uppercase letters to their 0x20 bits
+            return v | (BytesInRange(v, 'A', 'Z') >> 2);
+        }
+
+        //! The 0x80 bits of all bytes, as 8 bits. Bit k is about byte k
+        std::uint64_t Gather(std::uint64_t bytes) {
+            return ((bytes >> 7) * 0x0102040810204080ull) >> 56;
+        }
+    }
+
+#if defined(UWWWU_KERNELS_X86)
+    // Every level has its own copy of the kernels. They all come out exactly the same as the SWAR ones.
+
+    UWWWU_TARGET("sse4.2")
+    std::size_t FindCandidateSse42(std::string_view text, std::size_t pos, std::size_t end, std::string_view lowerFind) {
+        // Matching both cases of each char is cheaper than folding every char of the text
+        const char firstLower = lowerFind[0];
+        const char firstUpper = CharTable::MakeUpper(firstLower);
+        const bool checkSecond = lowerFind.length() > 1;
+        const char secondLower = checkSecond ? lowerFind[1] : '\0';
+        const char secondUpper = CharTable::MakeUpper(secondLower);
+
+        // Leaves one char of room, for the second char's load
+        const std::size_t vectorEnd = (text.length() > 0) ? text.length() - 1 : 0;
+        const char* const data = text.data();
+        std::size_t i = pos;
+
+        const __m128i fl = _mm_set1_epi8(firstLower);
+        const __m128i fu = _mm_set1_epi8(firstUpper);
+        const __m128i sl = _mm_set1_epi8(secondLower);
+        const __m128i su = _mm_set1_epi8(secondUpper);
+
+        for (; (i < end) && (i + 16 <= vectorEnd); i += 16)
+        {
+            const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i match = _mm_or_si128(_mm_cmpeq_epi8(chars, fl), _mm_cmpeq_epi8(chars, fu));
+
+            if (checkSecond)
+            {
+                const __m128i nextChars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 1));
+                match = _mm_and_si128(match, _mm_or_si128(_mm_cmpeq_epi8(nextChars, sl), _mm_cmpeq_epi8(nextChars, su)));
+            }
+
+            const std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(match));
+            if (mask != 0)
+                return std::min(end, i + static_cast<std::size_t>(std::countr_zero(mask)));
+        }
+
+        // What's left is shorter than a vector
+        for (; i < end; i++)
+            if (IsCandidate(text, i, firstLower, firstUpper, checkSecond, secondLower, secondUpper))
+                return i;
+
+        return end;
+    }
+
+    UWWWU_TARGET("avx2")
+    std::size_t FindCandidateAvx2(std::string_view text, std::size_t pos, std::size_t end, std::string_view lowerFind) {
+        const char firstLower = lowerFind[0];
+        const char firstUpper = CharTable::MakeUpper(firstLower);
+        const bool checkSecond = lowerFind.length() > 1;
+        const char secondLower = checkSecond ? lowerFind[1] : '\0';
+        const char secondUpper = CharTable::MakeUpper(secondLower);
+
+        const std::size_t vectorEnd = (text.length() > 0) ? text.length() - 1 : 0;
+        const char* const data = text.data();
+        std::size_t i = pos;
+
+        const __m256i fl = _mm256_set1_epi8(firstLower);
+        const __m256i fu = _mm256_set1_epi8(firstUpper);
+        const __m256i sl = _mm256_set1_epi8(secondLower);
+        const __m256i su = _mm256_set1_epi8(secondUpper);
+
+        for (; (i < end) && (i + 32 <= vectorEnd); i += 32)
+        {
+            const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i match = _mm256_or_si256(_mm256_cmpeq_epi8(chars, fl), _mm256_cmpeq_epi8(chars, fu));
+
+            if (checkSecond)
+            {
+                const __m256i nextChars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 1));
+                match = _mm256_and_si256(match, _mm256_or_si256(_mm256_cmpeq_epi8(nextChars, sl), _mm256_cmpeq_epi8(nextChars, su)));
+            }
+
+            const std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(match));
+            if (mask != 0)
+                return std::min(end, i + static_cast<std::size_t>(std::countr_zero(mask)));
+        }
+
+        // What's left is shorter than a vector, but might still fill a half one.
+        // Not by calling FindCandidateSse42: That's not VEX-encoded, and would run with the upper halves of the registers still dirty
+        if ((i < end) && (i + 16 <= vectorEnd))
+        {
+            const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i match = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm256_castsi256_si128(fl)), _mm_cmpeq_epi8(chars, _mm256_castsi256_si128(fu)));
+
+            if (checkSecond)
+            {
+                const __m128i nextChars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 1));
+                match = _mm_and_si128(match, _mm_or_si128(_mm_cmpeq_epi8(nextChars, _mm256_castsi256_si128(sl)), _mm_cmpeq_epi8(nextChars, _mm256_castsi256_si128(su))));
+            }
+
+            const std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(match));
+            if (mask != 0)
+                return std::min(end, i + static_cast<std::size_t>(std::countr_zero(mask)));
+
+            i += 16;
+        }
+
+        for (; i < end; i++)
+            if (IsCandidate(text, i, firstLower, firstUpper, checkSecond, secondLower, secondUpper))
+                return i;
+
+        return end;
+    }
+
+    UWWWU_TARGET("avx512f,avx512bw")
+    std::size_t FindCandidateAvx512bw(std::string_view text, std::size_t pos, std::size_t end, std::string_view lowerFind) {
+        const char firstLower = lowerFind[0];
+        const bool checkSecond = lowerFind.length() > 1;
+        const char secondLower = checkSecond ? lowerFind[1] : '\0';
+
+        const __m512i fl = _mm512_set1_epi8(firstLower);
+        const __m512i fu = _mm512_set1_epi8(CharTable::MakeUpper(firstLower));
+        const __m512i sl = _mm512_set1_epi8(secondLower);
+        const __m512i su = _mm512_set1_epi8(CharTable::MakeUpper(secondLower));
+
+        const std::size_t vectorEnd = (text.length() > 0) ? text.length() - 1 : 0;
+        const char* const data = text.data();
+        std::size_t i = pos;
+
+        for (; (i < end) && (i + 64 <= vectorEnd); i += 64)
+        {
+            const __m512i chars = _mm512_loadu_si512(data + i);
+            __mmask64 match = _mm512_cmpeq_epi8_mask(chars, fl) | _mm512_cmpeq_epi8_mask(chars, fu);
+
+            if (checkSecond)
+            {
+                const __m512i nextChars = _mm512_loadu_si512(data + i + 1);
+                match &= _mm512_cmpeq_epi8_mask(nextChars, sl) | _mm512_cmpeq_epi8_mask(nextChars, su);
+            }
+
+            if (match != 0)
+                return std::min(end, i + static_cast<std::size_t>(std::countr_zero(static_cast<std::uint64_t>(match))));
+        }
+
+        // Masked loads don't touch the chars masked off, so there is no scalar tail: The rest just gets loaded partially
+        if (i < end)
+        {
+            const std::size_t count = std::min<std::size_t>(64, end - i);
+            const __mmask64 lanes = (count == 64) ? ~__mmask64{ 0 } : ((__mmask64{ 1 } << count) - 1);
+            const __m512i chars = _mm512_maskz_loadu_epi8(lanes, data + i);
+            __mmask64 match = lanes & (_mm512_cmpeq_epi8_mask(chars, fl) | _mm512_cmpeq_epi8_mask(chars, fu));
+
+            if (checkSecond)
+            {
+                // A finding of two or more chars can't start on the last one
+                const std::size_t nextCount = std::min<std::size_t>(64, text.length() - i - 1);
+                const __mmask64 nextLanes = (nextCount == 64) ? ~__mmask64{ 0 } : ((__mmask64{ 1 } << nextCount) - 1);
+                const __m512i nextChars = _mm512_maskz_loadu_epi8(nextLanes, data + i + 1);
+                match &= nextLanes & (_mm512_cmpeq_epi8_mask(nextChars, sl) | _mm512_cmpeq_epi8_mask(nextChars, su));
+            }
+
+            if (match != 0)
+                return i + static_cast<std::size_t>(std::countr_zero(static_cast<std::uint64_t>(match)));
+        }
+
+        return end;
+    }
+
+    UWWWU_TARGET("sse4.2")
+    void ClassifySse42(std::string_view text, std::uint64_t* letters, std::uint64_t* vowels, std::uint64_t* uppers) {
+        const char* const data = text.data();
+
+        // Bytes are compared signed, so everything from 0x80 up is below 'A', and never counts as a letter
+        const __m128i caseBit = _mm_set1_epi8(0x20);
+        const __m128i beforeA = _mm_set1_epi8('A' - 1);
+        const __m128i afterZ = _mm_set1_epi8('Z' + 1);
+        const __m128i beforeLowerA = _mm_set1_epi8('a' - 1);
+        const __m128i afterLowerZ = _mm_set1_epi8('z' + 1);
+        const __m128i a = _mm_set1_epi8('a');
+        const __m128i e = _mm_set1_epi8('e');
+        const __m128i iVowel = _mm_set1_epi8('i');
+        const __m128i o = _mm_set1_epi8('o');
+        const __m128i u = _mm_set1_epi8('u');
+
+        // Short texts are common, so the last few chars get padded to a full word, rather than classified one by one
+        char padded[64];
+
+        for (std::size_t i = 0; i < text.length(); i += 64)
+        {
+            const char* word = data + i;
+            if (i + 64 > text.length())
+            {
+                std::memset(padded, 0, sizeof(padded));
+                std::memcpy(padded, word, text.length() - i);
+                word = padded;
+            }
+
+            std::uint64_t letterBits = 0;
+            std::uint64_t vowelBits = 0;
+            std::uint64_t upperBits = 0;
+
+            for (std::size_t part = 0; part < 4; part++)
+            {
+                const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(word + 16 * part));
+                const __m128i lower = _mm_or_si128(chars, caseBit);
+
+                const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(chars, beforeA), _mm_cmpgt_epi8(afterZ, chars));
+                const __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, beforeLowerA), _mm_cmpgt_epi8(afterLowerZ, lower));
+                const __m128i vowel = _mm_and_si128(letter, _mm_or_si128(
+                        _mm_or_si128(_mm_cmpeq_epi8(lower, a), _mm_cmpeq_epi8(lower, e)),
+                        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(lower, iVowel), _mm_cmpeq_epi8(lower, o)), _mm_cmpeq_epi8(lower, u))
+                ));
+
+                letterBits |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(letter))) << (16 * part);
+                vowelBits |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(vowel))) << (16 * part);
+                upperBits |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(upper))) << (16 * part);
+            }
+
+            letters[i / 64] = letterBits;
+            vowels[i / 64] = vowelBits;
+            uppers[i / 64] = upperBits;
+        }
+    }
+
+    UWWWU_TARGET("avx2")
+    void ClassifyAvx2(std::string_view text, std::uint64_t* letters, std::uint64_t* vowels, std::uint64_t* uppers) {
+        const char* const data = text.data();
+
+        const __m256i caseBit = _mm256_set1_epi8(0x20);
+        const __m256i beforeA = _mm256_set1_epi8('A' - 1);
+        const __m256i afterZ = _mm256_set1_epi8('Z' + 1);
+        const __m256i beforeLowerA = _mm256_set1_epi8('a' - 1);
+        const __m256i afterLowerZ = _mm256_set1_epi8('z' + 1);
+        const __m256i a = _mm256_set1_epi8('a');
+        const __m256i e = _mm256_set1_epi8('e');
+        const __m256i iVowel = _mm256_set1_epi8('i');
+        const __m256i o = _mm256_set1_epi8('o');
+        const __m256i u = _mm256_set1_epi8('u');
+
+        char padded[64];
+
+        for (std::size_t i = 0; i < text.length(); i += 64)
+        {
+            const char* word = data + i;
+            if (i + 64 > text.length())
+            {
+                std::memset(padded, 0, sizeof(padded));
+                std::memcpy(padded, word, text.length() - i);
+                word = padded;
+            }
+
+            std::uint64_t letterBits = 0;
+            std::uint64_t vowelBits = 0;
+            std::uint64_t upperBits = 0;
+
+            for (std::size_t part = 0; part < 2; part++)
+            {
+                const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(word + 32 * part));
+                const __m256i lower = _mm256_or_si256(chars, caseBit);
+
+                const __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(chars, beforeA), _mm256_cmpgt_epi8(afterZ, chars));
+                const __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(lower, beforeLowerA), _mm256_cmpgt_epi8(afterLowerZ, lower));
+                const __m256i vowel = _mm256_and_si256(letter, _mm256_or_si256(
+                        _mm256_or_si256(_mm256_cmpeq_epi8(lower, a), _mm256_cmpeq_epi8(lower, e)),
+                        _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(lower, iVowel), _mm256_cmpeq_epi8(lower, o)), _mm256_cmpeq_epi8(lower, u))
+                ));
+
+                letterBits |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(letter))) << (32 * part);
+                vowelBits |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(vowel))) << (32 * part);
+                upperBits |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(upper))) << (32 * part);
+            }
+
+            letters[i / 64] = letterBits;
+            vowels[i / 64] = vowelBits;
+            uppers[i / 64] = upperBits;
+        }
+    }
+
+    UWWWU_TARGET("avx512f,avx512bw")
+    void ClassifyAvx512bw(std::string_view text, std::uint64_t* letters, std::uint64_t* vowels, std::uint64_t* uppers) {
+        const char* const data = text.data();
+
+        const __m512i caseBit = _mm512_set1_epi8(0x20);
+        const __m512i upperA = _mm512_set1_epi8('A');
+        const __m512i lowerA = _mm512_set1_epi8('a');
+        const __m512i alphabet = _mm512_set1_epi8(26);
+        const __m512i e = _mm512_set1_epi8('e');
+        const __m512i iVowel = _mm512_set1_epi8('i');
+        const __m512i o = _mm512_set1_epi8('o');
+        const __m512i u = _mm512_set1_epi8('u');
+
+        // A word of bits is exactly one vector. The last one gets loaded partially, with zeros past the end, which aren't letters
+        for (std::size_t i = 0; i < text.length(); i += 64)
+        {
+            const std::size_t count = std::min<std::size_t>(64, text.length() - i);
+            const __mmask64 lanes = (count == 64) ? ~__mmask64{ 0 } : ((__mmask64{ 1 } << count) - 1);
+            const __m512i chars = _mm512_maskz_loadu_epi8(lanes, data + i);
+            const __m512i lower = _mm512_or_si512(chars, caseBit);
+
+            // Unsigned, chars below 'A' wrap around to way above 26
+            const __mmask64 upper = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(chars, upperA), alphabet);
+            const __mmask64 letter = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(lower, lowerA), alphabet);
+            const __mmask64 vowel = letter & (
+                    _mm512_cmpeq_epi8_mask(lower, lowerA) | _mm512_cmpeq_epi8_mask(lower, e) | _mm512_cmpeq_epi8_mask(lower, iVowel) |
+                    _mm512_cmpeq_epi8_mask(lower, o) | _mm512_cmpeq_epi8_mask(lower, u)
+            );
+
+            letters[i / 64] = letter;
+            vowels[i / 64] = vowel;
+            uppers[i / 64] = upper;
+        }
+    }
+
+    //! Has the CPU fill `registers` (eax, ebx, ecx, edx) with what it knows about `leaf`
+    void Cpuid(unsigned int leaf, unsigned int registers[4]) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int values[4];
+        __cpuidex(values, static_cast<int>(leaf), 0);
+        for (int r = 0; r < 4; r++)
+            registers[r] = static_cast<unsigned int>(values[r]);
+#else
+        __cpuid_count(leaf, 0, registers[0], registers[1], registers[2], registers[3]);
+#endif
+    }
+
+    //! Which registers the OS saves on context switches. Without that, the CPU having them doesn't help
+    std::uint64_t SavedRegisters() {
+#if defined(_MSC_VER) && !defined(__clang__)
+        return _xgetbv(0);
+#else
+        std::uint32_t low;
+        std::uint32_t high;
+        __asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+        return (static_cast<std::uint64_t>(high) << 32) | low;
+#endif
+    }
+
+    //! The best level this CPU has, as far as cpuid knows
+    Kernels::Level CpuLevel() {
+        unsigned int registers[4];
+        Cpuid(0, registers);
+        const unsigned int maxLeaf = registers[0];
+
+        Cpuid(1, registers);
+        const bool sse42 = (registers[2] >> 20) & 1;
+        const bool osxsave = (registers[2] >> 27) & 1;
+        if (!sse42)
+            return Kernels::Level::scalar;
+
+        // The OS has to save the xmm and ymm registers for AVX, and the opmask and zmm ones on top of them, for AVX-512
+        const std::uint64_t saved = osxsave ? SavedRegisters() : 0;
+        const bool osAvx = (saved & 0x06) == 0x06;
+        const bool osAvx512 = (saved & 0xE6) == 0xE6;
+        if ((maxLeaf < 7) || (!osAvx))
+            return Kernels::Level::sse42;
+
+        Cpuid(7, registers);
+        const bool avx2 = (registers[1] >> 5) & 1;
+        const bool avx512f = (registers[1] >> 16) & 1;
+        const bool avx512bw = (registers[1] >> 30) & 1;
+
+        if ((avx512f) && (avx512bw) && (avx2) && (osAvx512))
+            return Kernels::Level::avx512bw;
+        if (avx2)
+            return Kernels::Level::avx2;
+        return Kernels::Level::sse42;
+    }
+#endif
+
+    //! One level's worth of kernels
+    struct Implementation {
+        Kernels::Level level;
+        std::size_t (*findCandidate)(std::string_view text, std::size_t pos, std::size_t end, std::string_view lowerFind);
+        void (*classify)(std::string_view text, std::uint64_t* letters, std::uint64_t* vowels, std::uint64_t* uppers);
+    };
+
+    //! All of them, by level
+    constexpr Implementation implementations[] = {
+            { Kernels::Level::scalar, &Kernels::FindCandidateSwar, &Kernels::ClassifySwar },
+#if defined(UWWWU_KERNELS_X86)
+            { Kernels::Level::sse42, &FindCandidateSse42, &ClassifySse42 },
+            { Kernels::Level::avx2, &FindCandidateAvx2, &ClassifyAvx2 },
+            { Kernels::Level::avx512bw, &FindCandidateAvx512bw, &ClassifyAvx512bw },
+#endif
+    };
+
+    //! What UWWWU_KERNELS asks for, if this CPU can do it. Else the best there is
+    Kernels::Level StartupLevel() {
+        const Kernels::Level best = Kernels::BestLevel();
+
+        const char* const forced = std::getenv("UWWWU_KERNELS");
+        if ((forced == nullptr) || (*forced == '\0'))
+            return best;
+
+        Kernels::Level level;
+        if (!Kernels::ParseLevel(forced, level))
+            std::fprintf(stderr, "UWWWU_KERNELS: Unknown level %s, using %s\n", forced, Kernels::LevelName(best));
+        else if (level > best)
+            std::fprintf(stderr, "UWWWU_KERNELS: This CPU can't do %s, using %s\n", forced, Kernels::LevelName(best));
+        else
+            return level;
+
+        return best;
+    }
+
+    const Implementation& Resolve();
+
+    // Stand-ins, until the first call picks the level. From then on, calls go straight to the picked kernels
+    std::size_t FindCandidateResolving(std::string_view text, std::size_t pos, std::size_t end, std::string_view lowerFind) {
+        return Resolve().findCandidate(text, pos, end, lowerFind);
+    }
+
+    void ClassifyResolving(std::string_view text, std::uint64_t* letters, std::uint64_t* vowels, std::uint64_t* uppers) {
+        Resolve().classify(text, letters, vowels, uppers);
+    }
+
+    constexpr Implementation resolving = { Kernels::Level::scalar, &FindCandidateResolving, &ClassifyResolving };
+
+    //! The kernels calls go to. Only ever points to constants, so loading it relaxed is fine
+    std::atomic<const Implementation*> active{ &resolving };
+
+    //! Picks the startup level, unless it's been picked already
+    const Implementation& Resolve() {
+        static const Kernels::Level startup = StartupLevel();
+
+        // Another thread, or UseLevel(), might have been first
+        const Implementation* current = &resolving;
+        const Implementation* const picked = &implementations[static_cast<std::size_t>(startup)];
+        if (active.compare_exchange_strong(current, picked))
+            return *picked;
+
+        return *current;
+    }
+}
+
+std::size_t Kernels::FindCandidate(std::string_view text, std::size_t pos, std::size_t end, std::string_view lowerFind)
+{
+    return active.load(std::memory_order_relaxed)->findCandidate(text, pos, end, lowerFind);
+}
+
+void Kernels::Classify(std::string_view text, std::uint64_t* letters, std::uint64_t* vowels, std::uint64_t* uppers)
+{
+    active.load(std::memory_order_relaxed)->classify(text, letters, vowels, uppers);
+}
+
+Kernels::Level Kernels::BestLevel()
+{
+#if defined(UWWWU_KERNELS_X86)
+    static const Level best = CpuLevel();
+    return best;
+#else
+    return Level::scalar;
+#endif
+}
+
+Kernels::Level Kernels::ActiveLevel()
+{
+    return Resolve().level;
+}
+
+bool Kernels::UseLevel(Level level)
+{
+    if (level > BestLevel())
+        return false;
+
+    active.store(&implementations[static_cast<std::size_t>(level)]);
+    return true;
+}
+
+const char* Kernels::LevelName(Level level)
+{
+    switch (level)
+    {
+        case Level::scalar:
+            return "scalar";
+        case Level::sse42:
+            return "sse4.2";
+        case Level::avx2:
+            return "avx2";
+        case Level::avx512bw:
+            return "avx512bw";
+    }
+
+    return "unknown";
+}
+
+bool Kernels::ParseLevel(std::string_view name, Level& level)
+{
+    for (const Level candidate : { Level::scalar, Level::sse42, Level::avx2, Level::avx512bw })
+        if (name == LevelName(candidate))
+        {
+            level = candidate;
+            return true;
+        }
+
+    return false;
+}
+
+std::size_t Kernels::FindCandidateSwar(std::string_view text, std::size_t pos, std::size_t end, std::string_view lowerFind)
+{
+    const char firstLower = lowerFind[0];
+    const char firstUpper = CharTable::MakeUpper(firstLower);
+    const bool checkSecond = lowerFind.length() > 1;
+    const char secondLower = checkSecond ? lowerFind[1] : '\0';
+    const char secondUpper = CharTable::MakeUpper(secondLower);
+
+    // Leaves one char of room, for the second char's load
+    const std::size_t wordEnd = (text.length() > 0) ? text.length() - 1 : 0;
+    const char* const data = text.data();
+    std::size_t i = pos;
+
+    for (; (i < end) && (i + 8 <= wordEnd); i += 8)
+    {
+        const std::uint64_t chars = Swar::Load(data + i);
+        std::uint64_t match = Swar::EqualBytes(chars, firstLower) | Swar::EqualBytes(chars, firstUpper);
+
+        if (checkSecond)
+        {
+            const std::uint64_t nextChars = Swar::Load(data + i + 1);
+            match &= Swar::EqualBytes(nextChars, secondLower) | Swar::EqualBytes(nextChars, secondUpper);
+        }
+
+        if (match != 0)
+            return std::min(end, i + static_cast<std::size_t>(std::countr_zero(match)) / 8);
+    }
+
+    // What's left is shorter than a word
+    for (; i < end; i++)
+        if (IsCandidate(text, i, firstLower, firstUpper, checkSecond, secondLower, secondUpper))
+            return i;
+
+    return end;
+}
+
+void Kernels::ClassifySwar(std::string_view text, std::uint64_t* letters, std::uint64_t* vowels, std::uint64_t* uppers)
+{
+    const char* const data = text.data();
+
+    // Short texts are common, so the last few chars get padded to a full part, rather than classified one by one
+    char padded[64];
+
+    for (std::size_t i = 0; i < text.length(); i += 64)
+    {
+        const char* word = data + i;
+        std::size_t parts = 8;
+        if (i + 64 > text.length())
+        {
+            const std::size_t left = text.length() - i;
+            parts = (left + 7) / 8;
+            std::memset(padded + 8 * (parts - 1), 0, 8);
+            std::memcpy(padded, word, left);
+            word = padded;
+        }
+
+        std::uint64_t letterBits = 0;
+        std::uint64_t vowelBits = 0;
+        std::uint64_t upperBits = 0;
+
+        for (std::size_t part = 0; part < parts; part++)
+        {
+            const std::uint64_t chars = Swar::Load(word + 8 * part);
+
+            // Letters only differ from their other case in the 0x20 bit, so setting it makes every letter lowercase
+            const std::uint64_t lower = chars | (Swar::ones * 0x20);
+            const std::uint64_t letter = Swar::BytesInRange(lower, 'a', 'z');
+            const std::uint64_t vowel = letter & (
+                    Swar::EqualBytes(lower, 'a') | Swar::EqualBytes(lower, 'e') | Swar::EqualBytes(lower, 'i') |
+                    Swar::EqualBytes(lower, 'o') | Swar::EqualBytes(lower, 'u')
+            );
+            const std::uint64_t upper = Swar::BytesInRange(chars, 'A', 'Z');
+
+            letterBits |= Swar::Gather(letter) << (8 * part);
+            vowelBits |= Swar::Gather(vowel) << (8 * part);
+            upperBits |= Swar::Gather(upper) << (8 * part);
+        }
+
+        letters[i / 64] = letterBits;
+        vowels[i / 64] = vowelBits;
+        uppers[i / 64] = upperBits;
+    }
+}
+
+bool Kernels::EqualsIgnoringCase(std::string_view text, std::string_view lowerFind)
+{
+    if (text.length() != lowerFind.length())
+        return false;
+
+    std::size_t i = 0;
+    for (; i + 8 <= text.length(); i += 8)
+        if (Swar::MakeLower(Swar::Load(text.data() + i)) != Swar::Load(lowerFind.data() + i))
+            return false;
+
+    for (; i < text.length(); i++)
+        if (CharTable::MakeLower(text[i]) != lowerFind[i])
+            return false;
+
+    return true;
+}
@@ -0,0 +1,57 @@
+#ifndef UWWWU_KERNELS_H
+#define UWWWU_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+//! The innermost loops of the scans, vectorized for whatever the CPU has.
+//! On x86, every level gets compiled in, and the best one this CPU supports is picked on the first call.
+//! Everything else gets SWAR (SIMD within a register): 8 chars at a time, packed into a std::uint64_t.
+class Kernels {
+public:
+    //! Returns the first index in [pos, end) at which `text` could start with `lowerFind`, or `end` if there is none.
+    //! Compares the first char of `lowerFind`, and the second one if it has one, ignoring case. `lowerFind` has to be lowercase already, and not empty.
+    //! Might look at chars of `text` past `end`, but never past its length.
+    static std::size_t FindCandidate(std::string_view text, std::size_t pos, std::size_t end, std::string_view lowerFind);
+
+    //! Classifies all chars of `text` into bitmaps, 64 chars per word: Bit k of word w is about `text[64 * w + k]`.
+    //! Sets a char's bit in `letters` if it's a letter, in `vowels` if it's a vowel, and in `uppers` if it's uppercase, just like CharTools would.
+    //! Each of them has to have room for (text.length() + 63) / 64 words. Bits past the end of `text` come out 0.
+    static void Classify(std::string_view text, std::uint64_t* letters, std::uint64_t* vowels, std::uint64_t* uppers);
+
+    //! Will check whether `text` equals `lowerFind`, ignoring the case of `text`. `lowerFind` has to be lowercase already.
+    //! Compares 8 chars at a time, on any target.
+    static bool EqualsIgnoringCase(std::string_view text, std::string_view lowerFind);
+
+    //! The SWAR flavours of FindCandidate and Classify, for targets without vectors. They come out exactly the same.
+    static std::size_t FindCandidateSwar(std::string_view text, std::size_t pos, std::size_t end, std::string_view lowerFind);
+    static void ClassifySwar(std::string_view text, std::uint64_t* letters, std::uint64_t* vowels, std::uint64_t* uppers);
+
+    //! The instruction sets the kernels come in. Each level needs all of the ones below it.
+    //! `scalar` is the SWAR flavour, which runs anywhere.
+    enum class Level {
+        scalar,
+        sse42,
+        avx2,
+        avx512bw
+    };
+
+    //! The best level this CPU, and this build, supports
+    static Level BestLevel();
+
+    //! The level FindCandidate and Classify run on.
+    //! That's BestLevel(), unless the environment variable UWWWU_KERNELS, or UseLevel(), says otherwise.
+    static Level ActiveLevel();
+
+    //! Will have the kernels run on `level` from now on. Returns false, and changes nothing, if the CPU can't do it.
+    static bool UseLevel(Level level);
+
+    //! "scalar", "sse4.2", "avx2", or "avx512bw"
+    static const char* LevelName(Level level);
+
+    //! Will set `level` to the one called `name`, as named by LevelName(). Returns false, if there is none.
+    static bool ParseLevel(std::string_view name, Level& level);
+};
+
+#endif //UWWWU_KERNELS_H
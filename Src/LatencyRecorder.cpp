@@ -0,0 +1,205 @@
+#include "LatencyRecorder.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace {
+    //! Orders the slow-log heap, fastest on top
+    bool Slower(const LatencyRecorder::SlowInput& a, const LatencyRecorder::SlowInput& b) {
+        return a.nanoseconds > b.nanoseconds;
+    }
+}
+
+std::size_t LatencyHistogram::BucketOf(std::uint64_t nanoseconds)
+{
+    // Small ones count exactly
+    if (nanoseconds < subBuckets)
+        return static_cast<std::size_t>(nanoseconds);
+
+    // Else: Which power of two, and which sixteenth of it
+    const std::size_t exponent = static_cast<std::size_t>(std::bit_width(nanoseconds)) - 1;
+    const std::size_t sub = static_cast<std::size_t>(nanoseconds >> (exponent - 4)) & (subBuckets - 1);
+
+    return subBuckets + (exponent - 4) * subBuckets + sub;
+}
+
+std::uint64_t LatencyHistogram::ValueOf(std::size_t bucket)
+{
+    if (bucket < subBuckets)
+        return bucket;
+
+    const std::size_t shift = (bucket - subBuckets) / subBuckets;
+    const std::uint64_t sub = bucket % subBuckets;
+    const std::uint64_t lowest = (subBuckets + sub) << shift;
+
+    return lowest + (std::uint64_t{ 1 } << shift) / 2;
+}
+
+void LatencyHistogram::Record(std::uint64_t nanoseconds)
+{
+    buckets[BucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+
+    std::uint64_t seen = max.load(std::memory_order_relaxed);
+    while ((nanoseconds > seen) && (!max.compare_exchange_weak(seen, nanoseconds, std::memory_order_relaxed)));
+}
+
+std::uint64_t LatencyHistogram::Count() const
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+std::uint64_t LatencyHistogram::Percentile(double p) const
+{
+    // Sum the buckets up, rather than trusting `count`, so that records happening meanwhile can't throw us off
+    std::uint64_t total = 0;
+    for (const std::atomic<std::uint64_t>& bucket : buckets)
+        total += bucket.load(std::memory_order_relaxed);
+
+    if (total == 0)
+        return 0;
+
+    const std::uint64_t rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(p * static_cast<double>(total))));
+
+    // The very top is known exactly
+    if (rank >= total)
+        return Max();
+
+    std::uint64_t seen = 0;
+    for (std::size_t b = 0; b < bucketCount; b++)
+    {
+        seen += buckets[b].load(std::memory_order_relaxed);
+        if (seen >= rank)
+            return std::min(ValueOf(b), Max());
+    }
+
+    return Max();
+}
+
+std::uint64_t LatencyHistogram::Max() const
+{
+    return max.load(std::memory_order_relaxed);
+}
+
+LatencyRecorder::LatencyRecorder(std::size_t slowCount, std::size_t slowLength)
+    : slowCount(slowCount), slowLength(slowLength)
+{
+}
+
+void LatencyRecorder::Record(std::string_view input, std::chrono::nanoseconds duration)
+{
+    const std::uint64_t nanoseconds = static_cast<std::uint64_t>(std::max<std::chrono::nanoseconds::rep>(duration.count(), 0));
+
+    overall.Record(nanoseconds);
+
+    std::size_t sizeBucket = 0;
+    while ((sizeBucket + 1 < sizeBucketCount) && (input.length() >= SizeBucketBegin(sizeBucket + 1)))
+        sizeBucket++;
+    bySize[sizeBucket].Record(nanoseconds);
+
+    // Most calls are nowhere near the slowest ones, and don't need to lock anything
+    if ((slowCount == 0) || (nanoseconds <= slowThreshold.load(std::memory_order_relaxed)))
+        return;
+
+    const std::lock_guard<std::mutex> lock(slowMutex);
+    if (slowest.size() == slowCount)
+    {
+        if (nanoseconds <= slowest.front().nanoseconds)
+            return;
+
+        std::pop_heap(slowest.begin(), slowest.end(), Slower);
+        slowest.pop_back();
+    }
+
+    slowest.push_back({ nanoseconds, input.length(), std::string(input.substr(0, slowLength)) });
+    std::push_heap(slowest.begin(), slowest.end(), Slower);
+
+    if (slowest.size() == slowCount)
+        slowThreshold.store(slowest.front().nanoseconds, std::memory_order_relaxed);
+}
+
+std::vector<LatencyRecorder::SlowInput> LatencyRecorder::Slowest() const
+{
+    std::vector<SlowInput> sorted;
+    {
+        const std::lock_guard<std::mutex> lock(slowMutex);
+        sorted = slowest;
+    }
+
+    std::sort(sorted.begin(), sorted.end(), Slower);
+
+    return sorted;
+}
+
+const LatencyHistogram& LatencyRecorder::Overall() const
+{
+    return overall;
+}
+
+const LatencyHistogram& LatencyRecorder::BySize(std::size_t bucket) const
+{
+    return bySize[std::min(bucket, sizeBucketCount - 1)];
+}
+
+std::size_t LatencyRecorder::SizeBucketBegin(std::size_t bucket)
+{
+    return (bucket == 0) ? 0 : (std::size_t{ 16 } << (2 * bucket));
+}
+
+void LatencyRecorder::PrintReport(std::FILE* file) const
+{
+    std::fprintf(file, "%-18s %10s %10s %10s %10s %10s %10s\n", "input bytes", "calls", "p50 us", "p90 us", "p99 us", "p999 us", "max us");
+
+    const auto printRow = [file](const char* label, const LatencyHistogram& histogram) {
+        std::fprintf(file, "%-18s %10llu %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                     label,
+                     (unsigned long long)histogram.Count(),
+                     static_cast<double>(histogram.Percentile(0.5)) / 1e3,
+                     static_cast<double>(histogram.Percentile(0.9)) / 1e3,
+                     static_cast<double>(histogram.Percentile(0.99)) / 1e3,
+                     static_cast<double>(histogram.Percentile(0.999)) / 1e3,
+                     static_cast<double>(histogram.Max()) / 1e3);
+    };
+
+    for (std::size_t b = 0; b < sizeBucketCount; b++)
+    {
+        if (bySize[b].Count() == 0)
+            continue;
+
+        char label[32];
+        if (b + 1 < sizeBucketCount)
+            std::snprintf(label, sizeof(label), "[%zu, %zu)", SizeBucketBegin(b), SizeBucketBegin(b + 1));
+        else
+            std::snprintf(label, sizeof(label), ">= %zu", SizeBucketBegin(b));
+
+        printRow(label, bySize[b]);
+    }
+
+    printRow("all", overall);
+}
+
+void LatencyRecorder::WriteSlowLog(std::FILE* file) const
+{
+    for (const SlowInput& input : Slowest())
+    {
+        std::fprintf(file, "%.1f\t%zu\t", static_cast<double>(input.nanoseconds) / 1e3, input.length);
+
+        // One input per line, no matter what's in it
+        for (const char c : input.text)
+        {
+            const unsigned char u = static_cast<unsigned char>(c);
+            if (c == '\\')
+                std::fputs("\\\\", file);
+            else if (c == '\n')
+                std::fputs("\\n", file);
+            else if (c == '\t')
+                std::fputs("\\t", file);
+            else if ((u < 0x20) || (u == 0x7F))
+                std::fprintf(file, "\\%03o", u);
+            else
+                std::fputc(c, file);
+        }
+
+        std::fputs((input.text.length() < input.length) ? "...\n" : "\n", file);
+    }
+}
@@ -0,0 +1,115 @@
+#ifndef UWWWU_LATENCYRECORDER_H
+#define UWWWU_LATENCYRECORDER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+//! Histogram of latencies, HDR-style: Buckets grow exponentially, and every power of two is split into 16 linear sub-buckets.
+//! So any latency, from a nanosecond to centuries, is kept to within about 6%, in a fixed few KiB.
+//! Recording is a single relaxed atomic add, so many threads can record into the same histogram at once.
+class LatencyHistogram {
+public:
+    void Record(std::uint64_t nanoseconds);
+
+    //! Number of latencies recorded
+    std::uint64_t Count() const;
+
+    //! Latency that a fraction `p` (0..1) of all recorded latencies are at or below, in nanoseconds. 0 if there are none.
+    std::uint64_t Percentile(double p) const;
+
+    //! Highest latency recorded, in nanoseconds (exact, not bucketed)
+    std::uint64_t Max() const;
+
+private:
+    static constexpr std::size_t subBuckets = 16;
+    static constexpr std::size_t bucketCount = subBuckets + (64 - 4) * subBuckets;
+
+    static std::size_t BucketOf(std::uint64_t nanoseconds);
+    //! Middle of the range of latencies falling into `bucket`
+    static std::uint64_t ValueOf(std::size_t bucket);
+
+    std::array<std::atomic<std::uint64_t>, bucketCount> buckets{};
+    std::atomic<std::uint64_t> count{ 0 };
+    std::atomic<std::uint64_t> max{ 0 };
+};
+
+//! Records how long calls took, overall and by the length of their input,
+//! and keeps the slowest inputs, so that latency spikes can be traced back to what caused them.
+//! Many threads may record at once.
+class LatencyRecorder {
+public:
+    //! Keeps the `slowCount` slowest inputs, each truncated to `slowLength` bytes.
+    explicit LatencyRecorder(std::size_t slowCount = 10, std::size_t slowLength = 256);
+
+    LatencyRecorder(const LatencyRecorder&) = delete;
+    LatencyRecorder& operator=(const LatencyRecorder&) = delete;
+
+    //! Records a call on `input` that took `duration`
+    void Record(std::string_view input, std::chrono::nanoseconds duration);
+
+    //! One of the slowest inputs
+    struct SlowInput {
+        std::uint64_t nanoseconds;
+        //! Untruncated length of the input
+        std::size_t length;
+        //! The input, truncated
+        std::string text;
+    };
+
+    //! The slowest inputs so far, slowest first
+    std::vector<SlowInput> Slowest() const;
+
+    //! All latencies recorded
+    const LatencyHistogram& Overall() const;
+
+    //! Inputs are bucketed by length: [0, 64), [64, 256), [256, 1Ki), ... up to [256Ki, 1Mi), and everything longer.
+    static constexpr std::size_t sizeBucketCount = 9;
+
+    //! Latencies of the inputs falling into size bucket `bucket`
+    const LatencyHistogram& BySize(std::size_t bucket) const;
+
+    //! Lowest input length falling into size bucket `bucket`
+    static std::size_t SizeBucketBegin(std::size_t bucket);
+
+    //! Prints p50/p90/p99/p999 and max, overall and by input size
+    void PrintReport(std::FILE* file) const;
+
+    //! Writes the slowest inputs to `file`, one per line, slowest first: microseconds, length, and the (truncated) input, C-escaped.
+    void WriteSlowLog(std::FILE* file) const;
+
+    //! Has MakeUwu record into `recorder`, or stop recording, if it's nullptr. `recorder` has to outlive its use.
+    static void Install(LatencyRecorder* recorder) {
+        active.store(recorder, std::memory_order_release);
+    }
+
+    //! The recorder MakeUwu records into, if any. Checking is all it costs, while there is none.
+    static LatencyRecorder* Active() {
+        return active.load(std::memory_order_acquire);
+    }
+
+private:
+    LatencyHistogram overall;
+    std::array<LatencyHistogram, sizeBucketCount> bySize;
+
+    const std::size_t slowCount;
+    const std::size_t slowLength;
+
+    //! Latency an input has to beat, to make it into the slow-log. Saves taking the lock for all the others
+    std::atomic<std::uint64_t> slowThreshold{ 0 };
+
+    //! Guards `slowest`, which is a min-heap on latency
+    mutable std::mutex slowMutex;
+    std::vector<SlowInput> slowest;
+
+    static inline std::atomic<LatencyRecorder*> active{ nullptr };
+};
+
+#endif //UWWWU_LATENCYRECORDER_H
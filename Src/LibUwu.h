@@ -4,356 +4,345 @@
 #include <StringTools.h>
 #include <CharTools.h>
 #include <string>
-#include <sstream>
+#include <string_view>
+#include <vector>
+#include <span>
 #include <functional>
-#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
 #include "Util.h"
+#include "Cascade.h"
+#include "Stats.h"
+#include "LatencyRecorder.h"
+#include "WorkStealingPool.h"
 
 // This validator will only replace findings, if they are a complete word, and not just part of a word.
-static inline auto ValidatorFindingIsCompleteWord(const std::string& original, const std::string& finding, const std::size_t index) -> bool {
-    // Quick-accept: Original-string length matches finding-string length
-    if (original.length() == finding.length())
-        return true;
-
-    bool lastCharBreaksWord = true; // Default is true, because this value stays in case there is no last/next char.
-    bool nextCharBreaksWord = true; // In this case, "no character" would imply the word to be broken.
-
-    // Assign surrounding chars, if possible
-    if (index > 0)
-        lastCharBreaksWord = !CharTools::IsLetter(original[index - 1]);
-    if (index + finding.length() < original.length())
-        nextCharBreaksWord = !CharTools::IsLetter(original[index + finding.length()]);
-
-    // If both the last and the next character are word-breaking, replace.
-    if (lastCharBreaksWord && nextCharBreaksWord)
-        return true;
-        // Else: don't
-    else
-        return false;
-}
+// It can be called both ways: With a Util::Finding (which is what MakeUwu does), or with the string, the finding and its index.
+// It's an object rather than a function, so that it can be inlined into the scans it's passed to.
+static constexpr struct {
+    bool operator()(const Util::Finding& finding) const {
+        // Replace, if both the last and the next character are word-breaking (or not there at all)
+        return (!finding.IsLetter(-1)) && (!finding.IsLetter(finding.Next()));
+    }
 
+    bool operator()(const std::string& original, const std::string& finding, const std::size_t index) const {
+        // Quick-accept: Original-string length matches finding-string length
+        if (original.length() == finding.length())
+            return true;
 
-//! Will make a boring string look sooper dooper kawaii and cute :3
-static inline std::string MakeUwu(std::string boringString) {
-    // Easy ones first
-    // none, lol
-
-    // Slightly more complex... Multichar replacements, but we have to keep capitalization...
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "th", "tw");
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "ove", "uv");
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "have", "haf");
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "tr", "tw");
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "up", "uwp");
-
-    // Let's do some language adjustments
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "twank you", "you're twe best <3333 xoxo", ValidatorFindingIsCompleteWord);
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "good", "sooper dooper", ValidatorFindingIsCompleteWord);
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "suwper", "sooper dooper", ValidatorFindingIsCompleteWord);
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "well", "sooper dooper", ValidatorFindingIsCompleteWord);
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "emacs", "vim", ValidatorFindingIsCompleteWord);
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "twanks", "you're twe best :33 xoxo", ValidatorFindingIsCompleteWord);
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "hello", "hiiiiiii", ValidatorFindingIsCompleteWord);
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "dear", "hiiiiiii", ValidatorFindingIsCompleteWord);
-
-    // Let's extend some phonetics
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "hi", "hiiiiiii");
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "ay", "aaay");
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "ey", "eeey");
-
-    // Replace N with Ny, but only if succeeded by a vowel, and not (preceded by an o and succeeded by an "e{nonletter}"): "one" has such a niche pronunciation...
-    boringString = Util::ConditionalReplaceButKeepSigns(
-            boringString,
-            "n",
-            "ny",
-            [](const std::string& original, const std::string& finding, const std::size_t index) {
-                // Don't replace, if we are on the last char
-                if (index + finding.length() == original.length())
-                    return false;
-
-                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
-                const bool haveLastchar = index > 0; // Do we even have a last char?
-                const char lastChar = haveLastchar ? CharTools::MakeLower(original[index - 1]) : '\0';
-
-                // Apply the complex "one\b"-rule:
-                // (don't replace if 'n' is preceded by 'o' and succeeded by 'e', which is succeeded by a word break)
-                {
-                    bool nextNextCharIsNotLetter = false;
-                    char nextNextChar;
+        bool lastCharBreaksWord = true; // Default is true, because this value stays in case there is no last/next char.
+        bool nextCharBreaksWord = true; // In this case, "no character" would imply the word to be broken.
 
-                    // How much length is left including `nextChar`?
-                    const std::size_t sizeLeft = original.length() - (index + finding.length());
+        // Assign surrounding chars, if possible
+        if (index > 0)
+            lastCharBreaksWord = !CharTable::IsLetter(original[index - 1]);
+        if (index + finding.length() < original.length())
+            nextCharBreaksWord = !CharTable::IsLetter(original[index + finding.length()]);
 
-                    // We have room to pick the nextNext char...
-                    if (sizeLeft > 1)
-                    {
-                        nextNextChar = CharTools::MakeLower(original[index + finding.length() + 1]);
-                        nextNextCharIsNotLetter = !CharTools::IsLetter(nextNextChar);
-                    }
+        // If both the last and the next character are word-breaking, replace.
+        return lastCharBreaksWord && nextCharBreaksWord;
+    }
+} ValidatorFindingIsCompleteWord;
+
+
+//! One of the rules MakeUwu is made of, by name, so that it can be looked at (and benchmarked) on its own.
+struct UwuRule {
+    const char* name;
+    Cascade::Stage stage;
+};
+
+//! All rules of MakeUwu, in the order they get applied.
+//! Every rule only ever looks at the direct neighbourhood of a finding,
+//! so MakeUwu pushes the text through all of them as one cascade, instead of doing one full pass per rule.
+//! Every rule does a constant amount of work per char, and grows the text by at most a constant factor,
+//! so MakeUwu takes linear time for any input, no matter how pathological.
+static inline const std::vector<UwuRule>& UwuRules() {
+    static const std::vector<UwuRule> rules = {
+        // Easy ones first
+        // none, lol
+
+        // Slightly more complex... Multichar replacements, but we have to keep capitalization...
+        { "th", Cascade::ReplaceButKeepSigns("th", "tw") },
+        { "ove", Cascade::ReplaceButKeepSigns("ove", "uv") },
+        { "have", Cascade::ReplaceButKeepSigns("have", "haf") },
+        { "tr", Cascade::ReplaceButKeepSigns("tr", "tw") },
+        { "up", Cascade::ReplaceButKeepSigns("up", "uwp") },
+
+        // Let's do some language adjustments
+        { "twank you", Cascade::ReplaceButKeepSigns("twank you", "you're twe best <3333 xoxo", ValidatorFindingIsCompleteWord) },
+        { "good", Cascade::ReplaceButKeepSigns("good", "sooper dooper", ValidatorFindingIsCompleteWord) },
+        { "suwper", Cascade::ReplaceButKeepSigns("suwper", "sooper dooper", ValidatorFindingIsCompleteWord) },
+        { "well", Cascade::ReplaceButKeepSigns("well", "sooper dooper", ValidatorFindingIsCompleteWord) },
+        { "emacs", Cascade::ReplaceButKeepSigns("emacs", "vim", ValidatorFindingIsCompleteWord) },
+        { "twanks", Cascade::ReplaceButKeepSigns("twanks", "you're twe best :33 xoxo", ValidatorFindingIsCompleteWord) },
+        { "hello", Cascade::ReplaceButKeepSigns("hello", "hiiiiiii", ValidatorFindingIsCompleteWord) },
+        { "dear", Cascade::ReplaceButKeepSigns("dear", "hiiiiiii", ValidatorFindingIsCompleteWord) },
+
+        // Let's extend some phonetics
+        { "hi", Cascade::ReplaceButKeepSigns("hi", "hiiiiiii") },
+        { "ay", Cascade::ReplaceButKeepSigns("ay", "aaay") },
+        { "ey", Cascade::ReplaceButKeepSigns("ey", "eeey") },
+
+        // Replace N with Ny, but only if succeeded by a vowel, and not (preceded by an o and succeeded by an "e{nonletter}"): "one" has such a niche pronunciation...
+        { "n", Cascade::ReplaceButKeepSigns(
+                "n",
+                "ny",
+                [](const Util::Finding& finding) {
+                    // Apply the complex "one\b"-rule:
+                    // (don't replace if 'n' is preceded by 'o' and succeeded by 'e', which is succeeded by a word break)
+                    if ((finding.Lower(-1) == 'o') && (finding.Lower(finding.Next()) == 'e') && (!finding.IsLetter(finding.Next(1))))
+                        return false;
+
+                    // Replace, if the next char is a vowel (which it isn't, if there is none)
+                    return finding.IsVowel(finding.Next());
+                }
+        ) },
+
+        // Replace R with W, but only if not succeeded by a non-vowel, and if it's not the first character of a word
+        { "r-before-vowel", Cascade::ReplaceButKeepSigns(
+                "r",
+                "w",
+                [](const Util::Finding& finding) {
+                    // Don't replace, if the next char is not a vowel (or there is none)
+                    if (!finding.IsVowel(finding.Next()))
+                        return false;
 
-                    const bool nextNextCharBreaksWord = (sizeLeft == 1) || (nextNextCharIsNotLetter);
+                    // Don't replace if the last char is not a letter (or there is none)
+                    return finding.IsLetter(-1);
+                }
+        ) },
+
+        // Replace C with W, but only if succeeded and preceeded by a vowel
+        { "c", Cascade::ReplaceButKeepSigns(
+                "c",
+                "w",
+                [](const Util::Finding& finding) {
+                    // Don't replace, if the next or the last char is not a vowel (or there is none)
+                    return (finding.IsVowel(finding.Next())) && (finding.IsVowel(-1));
+                }
+        ) },
+
+        // Replace L with W, but only if not followed or preceded by another L, and if it's not the first character of a word
+        { "l", Cascade::ReplaceButKeepSigns(
+                "l",
+                "w",
+                [](const Util::Finding& finding) {
+                    // Don't replace if the last char is not a letter (or there is none)
+                    if (!finding.IsLetter(-1))
+                        return false;
 
-                    // Don't replace if:
-                    // (lastChar == o) && (nextChar == e) && (nextNextCharBreaksWord)
-                    if ((haveLastchar) && (lastChar == 'o') && (nextChar == 'e') && (nextNextCharBreaksWord))
+                    // Our segment has to be at least three characters long, so an 'l' ending a two-char string stays
+                    if ((!finding.Has(finding.Next())) && (!finding.Has(-2)))
                         return false;
+
+                    return (finding.Lower(-1) != 'l') && (finding.Lower(finding.Next()) != 'l');
+                }
+        ) },
+
+        // Replace LL with WW, but only if followed by a vowel
+        { "ll", Cascade::ReplaceButKeepSigns(
+                "ll",
+                "ww",
+                [](const Util::Finding& finding) {
+                    return finding.IsVowel(finding.Next());
+                }
+        ) },
+
+        // Replace ER with A, but only if it's the last two letters of a word
+        { "er", Cascade::ReplaceButKeepSigns(
+                "er",
+                "a",
+                [](const Util::Finding& finding) {
+                    // Replace if the next char is not a letter, or if we're at the end of this line/segment
+                    return !finding.IsLetter(finding.Next());
                 }
+        ) },
+
+        // Replace R with W, but only (if it's preceeded by a vowel,
+        // or preceeded by another 'r',
+        // or if it's the first character of a word)
+        // and if it's not the last character of a word
+        { "r-after-vowel", Cascade::ReplaceButKeepSigns(
+                "r",
+                "w",
+                [](const Util::Finding& finding) {
+                    // Don't replace if it's the last character
+                    if (!finding.Has(finding.Next()))
+                        return false;
 
-                // Is this a vowel?
-                if (CharTools::IsVowel(nextChar))
-                    return true;
+                    // Do blindly replace if it's the first character
+                    if (!finding.Has(-1))
+                        return true;
 
-                // Else, don't replace
-                return false;
-            }
-    );
-
-    // Replace R with W, but only if not succeeded by a non-vowel, and if it's not the first character of a word
-    boringString = Util::ConditionalReplaceButKeepSigns(
-            boringString,
-            "r",
-            "w",
-            [](const std::string& original, const std::string& finding, const std::size_t index) {
-                // Don't replace, if we are on the last char
-                if (index + finding.length() == original.length())
-                    return false;
-
-                // Don't replace if we're at index 0
-                if (index == 0)
-                    return false;
-
-                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
-                const char lastChar = CharTools::MakeLower(original[index - 1]);
-
-                // Is this a non-vowel?
-                if (!CharTools::IsVowel(nextChar))
-                    return false;
-
-                // Don't replace if the last char is not a letter
-                if (!CharTools::IsLetter(lastChar))
-                    return false;
-
-                // Else, replace
-                return true;
-            }
-    );
-
-    // Replace C with W, but only if succeeded and preceeded by a vowel
-    boringString = Util::ConditionalReplaceButKeepSigns(
-            boringString,
-            "c",
-            "w",
-            [](const std::string& original, const std::string& finding, const std::size_t index) {
-                // Don't replace, if we are on the last char
-                if (index + finding.length() == original.length())
-                    return false;
-
-                // Don't replace if we're at index 0
-                if (index == 0)
-                    return false;
-
-                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
-                const char lastChar = CharTools::MakeLower(original[index - 1]);
-
-                // Don't replace, if the next char is not a vowel
-                if (!CharTools::IsVowel(nextChar))
-                    return false;
-
-                // Don't replace if the last char is not a vowel
-                if (!CharTools::IsVowel(lastChar))
-                    return false;
-
-                // Else, replace
-                return true;
-            }
-    );
-
-    // Replace L with W, but only if not followed or preceded by another L, and if it's not the first character of a word
-    boringString = Util::ConditionalReplaceButKeepSigns(
-            boringString,
-            "l",
-            "w",
-            [](const std::string& original, const std::string& finding, const std::size_t index) {
-                // Our segment has to be at least two characters long
-                if (original.length() < finding.length() + 2)
-                    return false;
-
-                // Don't replace if we're at index o
-                if (index == 0)
-                    return false;
-
-                const char lastChar = CharTools::MakeLower(original[index - 1]);
-                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
-
-                // Don't replace if the last char is not a letter
-                if (!CharTools::IsLetter(lastChar))
-                    return false;
-
-                return (lastChar != 'l') && (nextChar != 'l');
-            }
-    );
+                    // Don't replace, if the last or the next char is not a letter
+                    if ((!finding.IsLetter(-1)) || (!finding.IsLetter(finding.Next())))
+                      return false;
 
-    // Replace LL with WW, but only if followed by a vowel
-    boringString = Util::ConditionalReplaceButKeepSigns(
-            boringString,
-            "ll",
-            "ww",
-            [](const std::string& original, const std::string& finding, const std::size_t index) {
-                // Don't replace, if we are on the last char
-                if (index + finding.length() == original.length())
-                    return false;
+                    // Replace, if the last character is an 'r' aswell, or a vowel
+                    return (finding.Lower(-1) == 'r') || (finding.IsVowel(-1));
+                }
+        ) },
+
+        // Replace y with y-y (imitates shy stuttering), but only sometimes (random change),
+        // and if it is the first character of a word,
+        // and if it is followed by a vowel
+        { "y", [](const std::string& in, std::size_t pos, bool final, std::string& out, const Cascade::RunInfo& run) {
+            return Util::ConditionalReplaceButKeepSignsInto(
+                    in,
+                    pos,
+                    final,
+                    "y",
+                    "y-y",
+                    [&run](const Util::Finding& finding) {
+                        // Don't replace, if the last char is a letter (no need to care about being on the first char: then there is none)
+                        if (finding.IsLetter(-1))
+                            return false;
+
+                        // Don't replace, if the next char is not a vowel (or there is none)
+                        if (!finding.IsVowel(finding.Next()))
+                            return false;
+
+                        // Chance (out of a 100) for the mutation to take place
+                        // if all preconditions are met
+                        constexpr int chance = 40;
+
+                        // Roll the dice, baby!
+                        // Every 'y' gets its own roll, derived from the run's key and its position.
+                        // No rng is shared between calls or threads, so neither of them can change the outcome.
+                        return (Util::Random(run.key, run.offset + finding.Index()) % 100) < chance;
+                    },
+                    out
+            );
+        } },
+
+        // Replace random punctuation with uwwwwu cute symbols
+        // About evewy fifteenth symbol
+        // Every symbol gets its own roll, derived from the run's key (a sequence apart from the stutter's) and the symbol's position.
+        // So there's no rng to set up or to carry along, and the rolls don't depend on how the text is split into blocks.
+        { "punctuation", [](const std::string& in, std::size_t pos, bool, std::string& out, const Cascade::RunInfo& run) {
+            for (; pos < in.length(); pos++)
+            {
+                const char c = in[pos];
+
+                // Roll the dice, but only for symbols that could get decorated
+                const bool isPunctuation = (c == '.') || (c == '!') || (c == ',') || (c == '?');
+                if constexpr (Stats::enabled)
+                    if (isPunctuation)
+                    {
+                        // Every symbol is a candidate, and the dice decide
+                        Stats::Count(Stats::candidates);
+                        Stats::Count(Stats::validatorCalls);
+                    }
 
-                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
+                if ((!isPunctuation) || (Util::Random(run.key + 1, run.offset + pos) % 15 != 0))
+                {
+                    out += c;
+                    continue;
+                }
 
-                return CharTools::IsVowel(nextChar);
-            }
-    );
-
-    // Replace ER with A, but only if it's the last two letters of a word
-    boringString = Util::ConditionalReplaceButKeepSigns(
-            boringString,
-            "er",
-            "a",
-            [](const std::string& original, const std::string& finding, const std::size_t index) {
-                // Replace if we're at the end of this line/segment
-                if (index + finding.length() == original.length())
-                    return true;
-
-                // Fetch the next char
-                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
-
-                // Replace if the next char is not a letter
-                return !CharTools::IsLetter(nextChar);
-            }
-    );
-
-    // Replace R with W, but only (if it's preceeded by a vowel,
-    // or preceeded by another 'r',
-    // or if it's the first character of a word)
-    // and if it's not the last character of a word
-    boringString = Util::ConditionalReplaceButKeepSigns(
-            boringString,
-            "r",
-            "w",
-            [](const std::string& original, const std::string& finding, const std::size_t index) {
-                // Don't replace if it's the last character
-                if (index + finding.length() == original.length())
-                    return false;
-
-                // Do blindly replace if it's the first character
-                if (index == 0)
-                    return true;
-
-                // Fetch the last character
-                const char lastChar = CharTools::MakeLower(original[index - 1]);
-
-                // Fetch the next char
-                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
-
-                // Don't replace, if the last char is not a letter
-                if (!CharTools::IsLetter(lastChar))
-                  return false;
-
-                // Don't replace, if the next char is not a letter
-                if (!CharTools::IsLetter(nextChar))
-                  return false;
-
-                // Replace, if the last character is an 'r' aswell
-                if (lastChar == 'r')
-                  return true;
-
-                // Replace, if the last character is a vowel.
-                return CharTools::IsVowel(lastChar);
-            }
-    );
-
-    // Replace y with y-y (imitates shy stuttering), but only sometimes (random change),
-    // and if it is the first character of a word,
-    // and if it is followed by a vowel
-    boringString = Util::ConditionalReplaceButKeepSigns(
-            boringString,
-            "y",
-            "y-y",
-            [boringString](const std::string& original, const std::string& finding, const std::size_t index) {
-                // Don't replace, if we're at the end of our string
-                if (index + finding.length() == original.length())
-                    return false;
-
-                // This is a bit tricky, because we can't abort if we're on the first char
-                // but we can can't not check the previous char either. Running big risk
-                // of causing a segfault. So we have to not check the previous character,
-                // if we are on the first char.
-
-                // Are we on the first char?
-                const bool isFirstChar = index == 0;
-
-                // Fetch the last character
-                const char lastChar = isFirstChar ? '\0' : CharTools::MakeLower(original[index - 1]);
-
-                // Fetch the next character
-                const char nextChar = CharTools::MakeLower(original[index + finding.length()]);
-
-                // Don't replace, if the last char is a letter
-                if ((!isFirstChar) && (CharTools::IsLetter(lastChar)))
-                    return false;
-
-                // Don't replace, if the next char is not a vowel
-                if (!CharTools::IsVowel(nextChar))
-                    return false;
-
-                // Initialize deterministic prng
-                // Can't initialize one for all scopes, they don't seem to play
-                // nicely with being passed to lambda functions...
-                static std::mt19937 rng(std::hash<std::string>()(boringString)); // Seed rng based on string
-
-                // Chance (out of a 100) for the mutation to take place
-                // if all preconditions are met
-                constexpr int chance = 40;
-
-                // Roll the dice, baby!
-                return (rng() % 100) < chance;
+                if constexpr (Stats::enabled)
+                    Stats::Count(Stats::accepts);
+
+                if (c == '.')
+                    out += " <3333 ^.^ ";
+                else if (c == '!')
+                    out += "!! Thadws impowtant! <3 ";
+                else if (c == ',')
+                    out += " <3 aaaaaand ";
+                else if (c == '?')
+                    out += "?? now tell me! >:( ";
             }
-    );
 
-    // Replace random punctuation with uwwwwu cute symbols
-    // About evewy fifteenth symbol
-    std::stringstream ss;
-    for (const char c : boringString)
-    {
-        // Initialize deterministic prng
-        std::mt19937 rng(std::hash<std::string>()(boringString)); // Seed rng based on string
+            return pos;
+        } },
+
+        // Also replace some ascii-"emojis', and do some language replacement that should happen after these more complex rules.
+        // All of these are looked for in the same scan.
+        { "emoticons", Cascade::MultiReplaceButKeepSigns({
+            // ":)" used to become "UwU :D", which in turn got its ":D" replaced
+            { ":)", "UwU :3", nullptr, false },
+            { ":D", ":3", nullptr, false },
+            { ":-)", "UwwwU :3", nullptr, false },
+            { "^^", "^.^ UwU", nullptr, false },
+            { "c++", "c++ (rust is hella cutewr btw ^^)" }
+        }) }
+    };
+
+    return rules;
+}
 
-        if ((c == '.') && (rng() % 15 == 0))
-        {
-            ss << " <3333 ^.^ ";
-        }
-        else if ((c == '!') && (rng() % 15 == 0))
-        {
-            ss << "!! Thadws impowtant! <3 ";
-        }
-        else if ((c == ',') && (rng() % 15 == 0))
-        {
-            ss << " <3 aaaaaand ";
-        }
-        else if ((c == '?') && (rng() % 15 == 0))
+//! Will make a boring string look sooper dooper kawaii and cute :3, and append it to `uwuString`.
+//! The same string and `seed` always come out the same, no matter what got uwu'd before, or on which thread.
+//! Safe to call from many threads at once: There is no shared mutable state, just per-call and per-thread buffers.
+//! While a LatencyRecorder is installed, every call gets timed into it.
+static inline void MakeUwu(std::string_view boringString, std::string& uwuString, std::uint64_t seed = 0) {
+    LatencyRecorder* const recorder = LatencyRecorder::Active();
+    const std::chrono::steady_clock::time_point start = (recorder != nullptr) ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+
+    // Every roll of the dice is derived from this
+    const std::uint64_t key = Util::Random(seed, Util::Hash(boringString));
+
+    static const Cascade uwu = []() {
+        Cascade cascade;
+        for (std::size_t r = 0; r < UwuRules().size(); r++)
         {
-            ss << "?? now tell me! >:( ";
+            // Have each rule count into its own Stats, if they're built in at all
+            if constexpr (Stats::enabled)
+                cascade.Then(Stats::Instrument(r, UwuRules()[r].stage));
+            else
+                cascade.Then(UwuRules()[r].stage);
         }
-        else
-            ss << c;
-    }
-    boringString = ss.str();
 
-    // Also replace some ascii-"emojis'
-    boringString = StringTools::Replace(boringString, ":)", "UwU :D");
-    boringString = StringTools::Replace(boringString, ":D", ":3");
-    boringString = StringTools::Replace(boringString, ":-)", "UwwwU :3");
-    boringString = StringTools::Replace(boringString, "^^", "^.^ UwU");
+        return cascade;
+    }();
+
+    uwu.Run(boringString, uwuString, key);
+
+    if (recorder != nullptr)
+        recorder->Record(boringString, std::chrono::steady_clock::now() - start);
+}
+
+//! Will make a boring string look sooper dooper kawaii and cute :3
+//! Same as above, but returns a new string.
+static inline std::string MakeUwu(std::string_view boringString, std::uint64_t seed = 0) {
+    std::string uwuString;
+    uwuString.reserve(boringString.length());
+    MakeUwu(boringString, uwuString, seed);
+
+    return uwuString;
+}
+
+//! Will uwu all of `boringStrings` into `uwuStrings`, which has to be just as long. Their old contents get replaced.
+//! Comes out the same as calling MakeUwu on each of them, but the strings get spread over WorkStealingPool::Shared(),
+//! so a few huge strings between lots of tiny ones don't leave the other threads idle.
+//! Passing in the same `uwuStrings` again and again reuses their memory. Another `pool` than the shared one sets the number of threads.
+static inline void MakeUwuBatch(std::span<const std::string_view> boringStrings, std::span<std::string> uwuStrings, std::uint64_t seed = 0, WorkStealingPool& pool = WorkStealingPool::Shared()) {
+    pool.ForEach(std::min(boringStrings.size(), uwuStrings.size()), [&](std::size_t i) {
+        uwuStrings[i].clear();
+        MakeUwu(boringStrings[i], uwuStrings[i], seed);
+    });
+}
+
+//! Will uwu all of `boringStrings`, spread over WorkStealingPool::Shared().
+//! Comes out the same as calling MakeUwu on each of them.
+static inline std::vector<std::string> MakeUwuBatch(std::span<const std::string_view> boringStrings, std::uint64_t seed = 0) {
+    std::vector<std::string> uwuStrings(boringStrings.size());
+    MakeUwuBatch(boringStrings, uwuStrings, seed);
+
+    return uwuStrings;
+}
 
-    // Some language replacement should happen after these more complex rules
-    boringString = Util::ConditionalReplaceButKeepSigns(boringString, "c++", "c++ (rust is hella cutewr btw ^^)");
+//! Prints which kernels MakeUwu runs on, and how often, and how expensively, each rule of it fired so far, on all threads.
+//! Only counts anything when built with UWWWU_STATS.
+static inline void PrintUwuStats(std::FILE* file) {
+    std::fprintf(file, "kernels: %s\n", Kernels::LevelName(Kernels::ActiveLevel()));
 
+    std::vector<std::string> names;
+    for (const UwuRule& rule : UwuRules())
+        names.emplace_back(rule.name);
 
-    return boringString;
+    Stats::Print(file, names);
 }
 
 #endif //UWWWU_LIBUWU_H
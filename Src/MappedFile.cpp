@@ -0,0 +1,250 @@
+#include "MappedFile.h"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define UWWWU_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+#ifdef UWWWU_HAVE_MMAP
+
+MappedFile MappedFile::Open(const std::string& path)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::runtime_error("Can't open " + path);
+
+    struct stat info{};
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        throw std::runtime_error("Can't stat " + path);
+    }
+
+    // Pipes and devices say they're empty, and can't be mapped anyway
+    if (!S_ISREG(info.st_mode))
+    {
+        close(fd);
+        throw std::runtime_error("Can't map " + path + ", as it's not a regular file. Pipe it into stdin instead");
+    }
+
+    MappedFile file;
+    file.size = static_cast<std::size_t>(info.st_size);
+
+    // Empty files can't be mapped, but there's nothing to map anyway
+    if (file.size > 0)
+    {
+        void* data = mmap(nullptr, file.size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            close(fd);
+            throw std::runtime_error("Can't map " + path);
+        }
+
+        // We're going to read it front to back
+        madvise(data, file.size, MADV_SEQUENTIAL);
+        file.data = static_cast<char*>(data);
+        file.mapping = data;
+        file.mappingSize = file.size;
+    }
+
+    // The mapping stays valid without the descriptor
+    close(fd);
+
+    return file;
+}
+
+MappedFile MappedFile::Create(const std::string& path, std::size_t size)
+{
+    const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        throw std::runtime_error("Can't create " + path);
+
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        close(fd);
+        throw std::runtime_error("Can't resize " + path);
+    }
+
+    MappedFile file;
+    file.size = size;
+
+    if (size > 0)
+    {
+        void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            close(fd);
+            throw std::runtime_error("Can't map " + path);
+        }
+
+        file.data = static_cast<char*>(data);
+        file.mapping = data;
+        file.mappingSize = size;
+    }
+
+    close(fd);
+
+    return file;
+}
+
+MappedFile MappedFile::Extend(const std::string& path, std::size_t offset, std::size_t size)
+{
+    const int fd = open(path.c_str(), O_RDWR);
+    if (fd < 0)
+        throw std::runtime_error("Can't open " + path);
+
+    if (ftruncate(fd, static_cast<off_t>(offset + size)) != 0)
+    {
+        close(fd);
+        throw std::runtime_error("Can't resize " + path);
+    }
+
+    MappedFile file;
+    file.size = size;
+
+    if (size > 0)
+    {
+        // Mappings have to start at a page boundary
+        const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+        const std::size_t skip = offset % pageSize;
+
+        void* data = mmap(nullptr, skip + size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, static_cast<off_t>(offset - skip));
+        if (data == MAP_FAILED)
+        {
+            close(fd);
+            throw std::runtime_error("Can't map " + path);
+        }
+
+        file.data = static_cast<char*>(data) + skip;
+        file.mapping = data;
+        file.mappingSize = skip + size;
+    }
+
+    close(fd);
+
+    return file;
+}
+
+MappedFile::~MappedFile()
+{
+    if (mapping != nullptr)
+        munmap(mapping, mappingSize);
+}
+
+void MappedFile::Release(std::size_t offset, std::size_t size) const
+{
+    // Only whole pages can go. The ones at the edges might still be needed
+    const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const std::size_t begin = (offset + pageSize - 1) / pageSize * pageSize;
+    const std::size_t end = std::min(offset + size, this->size) / pageSize * pageSize;
+
+    if ((data != nullptr) && (begin < end))
+        madvise(data + begin, end - begin, MADV_DONTNEED);
+}
+
+#else
+
+MappedFile MappedFile::Open(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in)
+        throw std::runtime_error("Can't open " + path);
+
+    // Pipes and devices can't tell their size
+    const std::streamoff length = in.tellg();
+    if (length < 0)
+        throw std::runtime_error("Can't read " + path + ", as it's not a regular file. Pipe it into stdin instead");
+
+    MappedFile file;
+    file.buffer.resize(static_cast<std::size_t>(length));
+    in.seekg(0);
+    in.read(file.buffer.data(), static_cast<std::streamsize>(file.buffer.size()));
+    file.data = file.buffer.data();
+    file.size = file.buffer.size();
+
+    return file;
+}
+
+MappedFile MappedFile::Create(const std::string& path, std::size_t size)
+{
+    // Make sure we can write there, before doing all the work
+    if (!std::ofstream(path, std::ios::binary | std::ios::trunc))
+        throw std::runtime_error("Can't create " + path);
+
+    MappedFile file;
+    file.buffer.resize(size);
+    file.data = file.buffer.data();
+    file.size = size;
+    file.writeTo = path;
+
+    return file;
+}
+
+MappedFile MappedFile::Extend(const std::string& path, std::size_t offset, std::size_t size)
+{
+    // Appending doesn't truncate what's there already
+    if (!std::ofstream(path, std::ios::binary | std::ios::app))
+        throw std::runtime_error("Can't open " + path);
+
+    MappedFile file;
+    file.buffer.resize(size);
+    file.data = file.buffer.data();
+    file.size = size;
+    file.writeTo = path;
+    file.writeOffset = offset;
+
+    return file;
+}
+
+void MappedFile::Release(std::size_t, std::size_t) const
+{
+    // It's all in the buffer anyway
+}
+
+MappedFile::~MappedFile()
+{
+    if (writeTo.empty())
+        return;
+
+    // Keeps what's before `writeOffset`
+    std::fstream out(writeTo, std::ios::binary | std::ios::in | std::ios::out);
+    out.seekp(static_cast<std::streamoff>(writeOffset));
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data(std::exchange(other.data, nullptr)),
+      size(std::exchange(other.size, 0)),
+      mapping(std::exchange(other.mapping, nullptr)),
+      mappingSize(std::exchange(other.mappingSize, 0)),
+      buffer(std::move(other.buffer)),
+      writeTo(std::exchange(other.writeTo, std::string())),
+      writeOffset(other.writeOffset)
+{
+    // A moved vector keeps its storage, so `data` stays valid
+}
+
+char* MappedFile::Data()
+{
+    return data;
+}
+
+const char* MappedFile::Data() const
+{
+    return data;
+}
+
+std::size_t MappedFile::Size() const
+{
+    return size;
+}
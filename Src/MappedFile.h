@@ -0,0 +1,54 @@
+#ifndef UWWWU_MAPPEDFILE_H
+#define UWWWU_MAPPEDFILE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+//! A file, mapped into memory.
+//! Where there's no mmap, the file gets read into (or written from) a buffer instead.
+//! Throws std::runtime_error if the file can't be opened, created or mapped.
+class MappedFile {
+public:
+    //! Maps `path` for reading. It has to be a regular file: Pipes and devices don't know their size.
+    static MappedFile Open(const std::string& path);
+
+    //! Creates (or truncates) `path` to `size` bytes, and maps it for writing.
+    //! The contents are flushed to the file, at the latest once this gets destroyed.
+    static MappedFile Create(const std::string& path, std::size_t size);
+
+    //! Grows the existing `path` to `offset + size` bytes, and maps just the `size` bytes from `offset` on, for writing.
+    //! That way, a file can be written window by window, without ever mapping (or buffering) all of it.
+    static MappedFile Extend(const std::string& path, std::size_t offset, std::size_t size);
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) = delete;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    //! Drops the pages of the `size` bytes from `offset` on out of memory, once done with them.
+    //! Reading there again reads them back in from the file. Only for files mapped by Open().
+    void Release(std::size_t offset, std::size_t size) const;
+
+    char* Data();
+    const char* Data() const;
+    std::size_t Size() const;
+
+private:
+    MappedFile() = default;
+
+    char* data = nullptr;
+    std::size_t size = 0;
+
+    //! What actually got mapped. Mappings start at page boundaries, so that might start a bit before `data`
+    void* mapping = nullptr;
+    std::size_t mappingSize = 0;
+
+    //! Where there's no mmap
+    std::vector<char> buffer;
+    std::string writeTo;
+    std::size_t writeOffset = 0;
+};
+
+#endif //UWWWU_MAPPEDFILE_H
@@ -0,0 +1,153 @@
+#include "Pipeline.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+Pipeline::Pipeline(
+        Transform transform,
+        std::size_t workers,
+        std::size_t batchLines,
+        std::size_t batchBytes,
+        std::size_t batchesInFlight
+)
+    : transform(std::move(transform)),
+      workers(std::max<std::size_t>(workers, 1)),
+      batchLines(std::max<std::size_t>(batchLines, 1)),
+      batchBytes(std::max<std::size_t>(batchBytes, 1)),
+      batchesInFlight(batchesInFlight > 0 ? batchesInFlight : 4 * this->workers)
+{
+}
+
+namespace {
+    struct Batch {
+        std::size_t sequence;
+        std::vector<std::string> lines;
+    };
+
+    //! Everything the threads of a run share
+    struct State {
+        std::mutex mutex;
+
+        //! Read, but not yet picked up by a worker
+        std::deque<Batch> pending;
+        //! Transformed, but not yet written. By sequence number
+        std::map<std::size_t, std::string> done;
+        //! Read, but not yet written
+        std::size_t inFlight = 0;
+        bool doneReading = false;
+
+        //! Signals the reader that a batch got written
+        std::condition_variable written;
+        //! Signals the workers that a batch got read, or that reading is over
+        std::condition_variable read;
+        //! Signals the writer that a batch got transformed
+        std::condition_variable transformed;
+    };
+}
+
+void Pipeline::Run(std::istream& in, std::ostream& out) const
+{
+    State state;
+    std::size_t batchesRead = 0;
+
+    // Reader: Cuts the input into batches, but never gets too far ahead of the writer
+    std::thread reader([&]() {
+        std::string line;
+        bool eof = false;
+        while (!eof)
+        {
+            Batch batch{ batchesRead, {} };
+            std::size_t bytes = 0;
+            while ((batch.lines.size() < batchLines) && (bytes < batchBytes))
+            {
+                if (!std::getline(in, line))
+                {
+                    eof = true;
+                    break;
+                }
+
+                bytes += line.length();
+                batch.lines.push_back(std::move(line));
+            }
+
+            std::unique_lock<std::mutex> lock(state.mutex);
+            if (!batch.lines.empty())
+            {
+                state.written.wait(lock, [&]() { return state.inFlight < batchesInFlight; });
+                state.inFlight++;
+                state.pending.push_back(std::move(batch));
+                batchesRead++;
+            }
+            if (eof)
+                state.doneReading = true;
+            lock.unlock();
+            state.read.notify_all();
+
+            // The writer might be waiting to find out whether there's more to come
+            if (eof)
+                state.transformed.notify_one();
+        }
+    });
+
+    // Workers: Transform batches as they come in, in no particular order
+    std::vector<std::thread> pool;
+    for (std::size_t w = 0; w < workers; w++)
+    {
+        pool.emplace_back([&]() {
+            while (true)
+            {
+                std::unique_lock<std::mutex> lock(state.mutex);
+                state.read.wait(lock, [&]() { return (!state.pending.empty()) || (state.doneReading); });
+                if (state.pending.empty())
+                    return;
+
+                Batch batch = std::move(state.pending.front());
+                state.pending.pop_front();
+                lock.unlock();
+
+                std::string result;
+                for (const std::string& line : batch.lines)
+                {
+                    result += transform(line);
+                    result += '\n';
+                }
+
+                lock.lock();
+                state.done.emplace(batch.sequence, std::move(result));
+                lock.unlock();
+                state.transformed.notify_one();
+            }
+        });
+    }
+
+    // Writer: Writes the batches in order, as soon as the next one is ready
+    for (std::size_t next = 0; ; next++)
+    {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        state.transformed.wait(lock, [&]() {
+            return (state.done.count(next) > 0) || ((state.doneReading) && (next == batchesRead));
+        });
+        if (state.done.count(next) == 0)
+            break;
+
+        const std::string result = std::move(state.done[next]);
+        state.done.erase(next);
+        lock.unlock();
+
+        out << result;
+        out.flush();
+
+        lock.lock();
+        state.inFlight--;
+        lock.unlock();
+        state.written.notify_one();
+    }
+
+    reader.join();
+    for (std::thread& worker : pool)
+        worker.join();
+}
@@ -0,0 +1,40 @@
+#ifndef UWWWU_PIPELINE_H
+#define UWWWU_PIPELINE_H
+
+#include <string>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <cstddef>
+
+//! Transforms a stream line by line, on multiple threads, but writes the results in input order.
+//! A reader thread cuts the input into batches of lines, the workers transform them, and the calling thread writes them out.
+//! Only a limited number of batches is in flight at any time, so memory stays bounded, even if the output is slow to drain.
+class Pipeline {
+public:
+    using Transform = std::function<std::string(const std::string&)>;
+
+    //! `transform` has to be safe to call from `workers` threads at once.
+    //! A batch is cut once it has `batchLines` lines, or `batchBytes` bytes, whichever comes first.
+    //! At most `batchesInFlight` batches are read but not yet written. 0 means: four per worker.
+    Pipeline(
+            Transform transform,
+            std::size_t workers,
+            std::size_t batchLines = 1024,
+            std::size_t batchBytes = 1 << 20,
+            std::size_t batchesInFlight = 0
+    );
+
+    //! Will write the transformed version of every line of `in` to `out`, each terminated by a newline.
+    //! Same output as calling `transform` on every line in order, just faster.
+    void Run(std::istream& in, std::ostream& out) const;
+
+private:
+    Transform transform;
+    std::size_t workers;
+    std::size_t batchLines;
+    std::size_t batchBytes;
+    std::size_t batchesInFlight;
+};
+
+#endif //UWWWU_PIPELINE_H
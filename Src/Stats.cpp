@@ -0,0 +1,108 @@
+#include "Stats.h"
+#include <algorithm>
+#include <mutex>
+
+namespace {
+    using ThreadCounters = std::array<std::atomic<std::uint64_t>, Stats::counterCount>;
+
+    //! Where all threads' counters are kept track of
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::array<ThreadCounters, Stats::maxRules>*> threads;
+        //! What threads counted before they exited
+        std::vector<Stats::Counters> retired = std::vector<Stats::Counters>(Stats::maxRules, Stats::Counters{});
+    };
+
+    Registry& GetRegistry() {
+        // Never destroyed, so that threads exiting after main() can still retire their counters
+        static Registry* registry = new Registry();
+        return *registry;
+    }
+
+    //! A thread's counters. Registered when first used, and retired when the thread exits.
+    struct LocalCounters {
+        std::array<ThreadCounters, Stats::maxRules> rules{};
+
+        LocalCounters() {
+            Registry& registry = GetRegistry();
+            const std::lock_guard<std::mutex> lock(registry.mutex);
+            registry.threads.push_back(&rules);
+        }
+
+        ~LocalCounters() {
+            Registry& registry = GetRegistry();
+            const std::lock_guard<std::mutex> lock(registry.mutex);
+            for (std::size_t r = 0; r < Stats::maxRules; r++)
+                for (std::size_t c = 0; c < Stats::counterCount; c++)
+                    registry.retired[r][c] += rules[r][c].load(std::memory_order_relaxed);
+
+            registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), &rules));
+        }
+    };
+
+    thread_local LocalCounters local;
+}
+
+Stats::ThreadCounters* Stats::Local(std::size_t rule)
+{
+    return &local.rules[std::min(rule, maxRules - 1)];
+}
+
+std::vector<Stats::Counters> Stats::Aggregate()
+{
+    Registry& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+
+    std::vector<Counters> sums = registry.retired;
+    for (const auto* thread : registry.threads)
+        for (std::size_t r = 0; r < maxRules; r++)
+            for (std::size_t c = 0; c < counterCount; c++)
+                sums[r][c] += (*thread)[r][c].load(std::memory_order_relaxed);
+
+    return sums;
+}
+
+void Stats::Reset()
+{
+    Registry& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+
+    registry.retired.assign(maxRules, Counters{});
+    for (auto* thread : registry.threads)
+        for (std::size_t r = 0; r < maxRules; r++)
+            for (std::size_t c = 0; c < counterCount; c++)
+                (*thread)[r][c].store(0, std::memory_order_relaxed);
+}
+
+void Stats::Print(std::FILE* file, const std::vector<std::string>& names)
+{
+    const std::vector<Counters> sums = Aggregate();
+
+    std::fprintf(file, "%-16s %12s %14s %10s %12s %12s %10s\n", "rule", "candidates", "validatorCalls", "accepts", "bytesIn", "bytesOut", "ms");
+
+    Counters total{};
+    for (std::size_t r = 0; (r < names.size()) && (r < maxRules); r++)
+    {
+        const Counters& rule = sums[r];
+        std::fprintf(file, "%-16s %12llu %14llu %10llu %12llu %12llu %10.3f\n",
+                     names[r].c_str(),
+                     (unsigned long long)rule[candidates],
+                     (unsigned long long)rule[validatorCalls],
+                     (unsigned long long)rule[accepts],
+                     (unsigned long long)rule[bytesIn],
+                     (unsigned long long)rule[bytesOut],
+                     static_cast<double>(rule[nanoseconds]) / 1e6);
+
+        for (std::size_t c = 0; c < counterCount; c++)
+            total[c] += rule[c];
+    }
+
+    // Bytes just go from one rule to the next, so only the time adds up to anything meaningful
+    std::fprintf(file, "%-16s %12llu %14llu %10llu %12s %12s %10.3f\n",
+                 "total",
+                 (unsigned long long)total[candidates],
+                 (unsigned long long)total[validatorCalls],
+                 (unsigned long long)total[accepts],
+                 "", "",
+                 static_cast<double>(total[nanoseconds]) / 1e6);
+}
@@ -0,0 +1,103 @@
+#ifndef UWWWU_STATS_H
+#define UWWWU_STATS_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+//! Opt-in counters of how often, and how expensively, each rule fires.
+//! Only counts anything when built with UWWWU_STATS defined. Else, all counting gets compiled out.
+//! Every thread counts into its own counters, so counting never contends. Aggregate() sums them up.
+class Stats {
+public:
+#ifdef UWWWU_STATS
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    //! What gets counted, per rule
+    enum Counter {
+        //! Positions a scan stopped at, because a finding could start there
+        candidates,
+        //! Findings a validator got asked about
+        validatorCalls,
+        //! Findings that actually got replaced
+        accepts,
+        //! Chars the rule consumed
+        bytesIn,
+        //! Chars the rule produced
+        bytesOut,
+        //! Time spent in the rule
+        nanoseconds,
+        counterCount
+    };
+
+    using Counters = std::array<std::uint64_t, counterCount>;
+
+    //! How many rules can be told apart
+    static constexpr std::size_t maxRules = 64;
+
+    //! Counts `n` on `counter` of the rule currently running on this thread, if any.
+    //! Scans call this for their candidates, validator calls and accepts. Call it behind an `if constexpr (enabled)`.
+    static void Count(Counter counter, std::uint64_t n = 1) {
+        if (current != nullptr)
+            Add((*current)[counter], n);
+    }
+
+    //! Wraps a Cascade stage, so that everything happening inside of it gets counted for rule number `rule`.
+    template<typename Stage>
+    static auto Instrument(std::size_t rule, Stage stage);
+
+    //! Sums of all threads' counters so far (including threads that have already exited), per rule number.
+    static std::vector<Counters> Aggregate();
+
+    //! Sets all counters back to zero. Counts happening at the same time might get lost.
+    static void Reset();
+
+    //! Prints the aggregate as a table, with a row per rule, named by `names` (rule number i is `names[i]`).
+    static void Print(std::FILE* file, const std::vector<std::string>& names);
+
+private:
+    using ThreadCounters = std::array<std::atomic<std::uint64_t>, counterCount>;
+
+    //! Only the owning thread ever writes its counters, so there's no need for a locked add
+    static void Add(std::atomic<std::uint64_t>& counter, std::uint64_t n) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    //! This thread's counters of rule number `rule`
+    static ThreadCounters* Local(std::size_t rule);
+
+    //! Counters of the rule running on this thread right now
+    static inline thread_local ThreadCounters* current = nullptr;
+};
+
+template<typename Stage>
+auto Stats::Instrument(std::size_t rule, Stage stage)
+{
+    return [rule, stage = std::move(stage)](const std::string& in, std::size_t pos, bool final, std::string& out, const auto& run) {
+        ThreadCounters* const counters = Local(rule);
+        ThreadCounters* const previous = std::exchange(current, counters);
+
+        const std::size_t outLength = out.length();
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        const std::size_t next = stage(in, pos, final, out, run);
+        const std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+
+        Add((*counters)[nanoseconds], static_cast<std::uint64_t>(elapsed.count()));
+        Add((*counters)[bytesIn], next - pos);
+        Add((*counters)[bytesOut], out.length() - outLength);
+
+        current = previous;
+        return next;
+    };
+}
+
+#endif //UWWWU_STATS_H
@@ -0,0 +1,81 @@
+#include "StdioStreamBuf.h"
+
+StdioStreamBuf::StdioStreamBuf(std::FILE* file)
+    : file(file)
+{
+    // Our buffer is the only one needed
+    std::setvbuf(file, nullptr, _IONBF, 0);
+}
+
+StdioStreamBuf::~StdioStreamBuf()
+{
+    sync();
+}
+
+StdioStreamBuf::int_type StdioStreamBuf::underflow()
+{
+    if (gptr() < egptr())
+        return traits_type::to_int_type(*gptr());
+
+    if (!inBuffer)
+        inBuffer = std::make_unique<char[]>(bufferSize);
+
+    const std::size_t count = std::fread(inBuffer.get(), 1, bufferSize, file);
+    if (count == 0)
+        return traits_type::eof();
+
+    setg(inBuffer.get(), inBuffer.get(), inBuffer.get() + count);
+    return traits_type::to_int_type(*gptr());
+}
+
+StdioStreamBuf::int_type StdioStreamBuf::overflow(int_type c)
+{
+    // Streams that only ever get read from never get an output buffer
+    if (!outBuffer)
+    {
+        outBuffer = std::make_unique<char[]>(bufferSize);
+        setp(outBuffer.get(), outBuffer.get() + bufferSize);
+    }
+    else if (!FlushOutput())
+        return traits_type::eof();
+
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+
+    return traits_type::not_eof(c);
+}
+
+std::streamsize StdioStreamBuf::xsputn(const char* s, std::streamsize count)
+{
+    // Big chunks go straight through, instead of being copied into the buffer first
+    const std::streamsize room = outBuffer ? epptr() - pptr() : static_cast<std::streamsize>(bufferSize);
+    if (count >= room)
+    {
+        if (!FlushOutput())
+            return 0;
+
+        return static_cast<std::streamsize>(std::fwrite(s, 1, static_cast<std::size_t>(count), file));
+    }
+
+    return std::streambuf::xsputn(s, count);
+}
+
+int StdioStreamBuf::sync()
+{
+    if ((!FlushOutput()) || (std::fflush(file) != 0))
+        return -1;
+
+    return 0;
+}
+
+bool StdioStreamBuf::FlushOutput()
+{
+    const std::size_t count = static_cast<std::size_t>(pptr() - pbase());
+    const bool written = (count == 0) || (std::fwrite(pbase(), 1, count, file) == count);
+    setp(pbase(), epptr());
+
+    return written;
+}
@@ -0,0 +1,37 @@
+#ifndef UWWWU_STDIOSTREAMBUF_H
+#define UWWWU_STDIOSTREAMBUF_H
+
+#include <cstdio>
+#include <memory>
+#include <streambuf>
+
+//! A stream buffer on top of a C FILE, such as stdin or stdout.
+//! Using this instead of std::cin and std::cout keeps <iostream> out of the binary,
+//! so that no process has to pay for constructing the standard streams on startup, just the ones that use streams.
+//! Buffers on the heap, and only in the direction it gets used in. It takes over the buffering from `file`, so nothing gets copied twice.
+class StdioStreamBuf : public std::streambuf {
+public:
+    //! Nothing may have been read from or written to `file` yet, as it gets its own buffering turned off
+    explicit StdioStreamBuf(std::FILE* file);
+    ~StdioStreamBuf() override;
+
+    StdioStreamBuf(const StdioStreamBuf&) = delete;
+    StdioStreamBuf& operator=(const StdioStreamBuf&) = delete;
+
+protected:
+    int_type underflow() override;
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char* s, std::streamsize count) override;
+    int sync() override;
+
+private:
+    bool FlushOutput();
+
+    static constexpr std::size_t bufferSize = 1 << 16;
+
+    std::FILE* file;
+    std::unique_ptr<char[]> inBuffer;
+    std::unique_ptr<char[]> outBuffer;
+};
+
+#endif //UWWWU_STDIOSTREAMBUF_H
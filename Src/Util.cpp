@@ -1,7 +1,6 @@
 #include "Util.h"
-#include <CharTools.h>
-#include <StringTools.h>
-#include <sstream>
+#include <algorithm>
+#include <iterator>
 
 std::string Util::ConditionalReplaceButKeepSigns(
         const std::string& str,
@@ -10,103 +9,390 @@ std::string Util::ConditionalReplaceButKeepSigns(
         const std::function<bool(const std::string&, const std::string&, const std::size_t)>& onlyIf
 )
 {
+    return ConditionalReplaceButKeepSigns<const Validator&>(str, std::move(find), sub, onlyIf);
+}
 
-    // Quick accepts-and rejects
-    if (str.length() == 0)
-        return "";
-    else if (find.length() == 0)
-        return str;
-
-    std::stringstream ss;
+std::size_t Util::ConditionalReplaceButKeepSignsInto(
+        const std::string& str,
+        std::size_t pos,
+        bool final,
+        std::string_view find,
+        std::string_view sub,
+        const std::function<bool(const std::string&, const std::string&, const std::size_t)>& onlyIf,
+        std::string& out
+)
+{
+    return ConditionalReplaceButKeepSignsInto<const Validator&>(str, pos, final, find, sub, onlyIf, out);
+}
 
-    // Better safe than sorry
-    find = StringTools::Lower(find);
+std::size_t Util::ReplaceInto(
+        const std::string& str,
+        std::size_t pos,
+        bool final,
+        std::string_view find,
+        std::string_view sub,
+        std::string& out
+)
+{
+    // Nothing to find? Just pass everything through
+    if (find.length() == 0)
+    {
+        out.append(str, pos, std::string::npos);
+        return str.length();
+    }
 
-    for (std::size_t i = 0; i < str.length(); i++)
+    while (true)
     {
-        const std::string foundInText = str.substr(i, find.length());
-        const std::string foundInText_lower = StringTools::Lower(foundInText);
-        if (foundInText_lower == find)
+        const std::size_t posFound = str.find(find, pos);
+
+        // No more occurrences... copy over what can't be the start of one anymore
+        if (posFound == std::string::npos)
         {
-            // Ask the callback if we should replace this one
-            if (onlyIf(str, foundInText, i))
+            const std::size_t end =
+                    final ? str.length() :
+                    (str.length() >= find.length()) ? str.length() - find.length() + 1 :
+                    pos;
+
+            if (end > pos)
             {
-                // Here we've found our occurrence...
-                // We have three possible cases:
-                // 1: len(find) == len(sub), in this case we want to sync capitalization by index.
-                // 2: len(find) < len(sub), in this case we sync by index, BUT...
-                // 3: len(find) > len(sub): sync capitalization by index
-
-                // We want to sync capitalization by index
-                // This accounts for both cases: 1 and 3
-                if (foundInText.length() >= sub.length())
-                {
-                    for (std::size_t j = 0; j < sub.length(); j++)
-                    {
-                        const char cf = foundInText[j];
-                        const char cs = sub[j];
-
-                        ss << CharTools::CopySign(cf, cs);
-                    }
-                }
-
-                    // in this case we sync by index, BUT...
-                else if (foundInText.length() < sub.length())
-                {
-                    char followingCharsSign = 0;
-                    bool doHaveFollowingChar = false;
-                    // Do we even have a following char?
-                    if (str.length() >= i + foundInText.length() + 1)
-                    {
-                        const char followingChar = str[i + foundInText.length()];
-
-                        // Is it a letter?
-                        if (CharTools::IsLetter(followingChar))
-                        {
-                            // Copy its sign
-                            followingCharsSign = followingChar;
-                            doHaveFollowingChar = true;
-                        }
-                    }
-
-
-                    char lastCharCharSign = 0;
-                    for (std::size_t j = 0; j < sub.length(); j++)
-                    {
-                        const char cs = sub[j];
-
-                        // Do we still have chars of 'find' left?
-                        if (j < foundInText.length())
-                        {
-                            // Yes: Just copy the sign as is, and update the last sign seen
-                            const char cf = foundInText[j];
-                            lastCharCharSign = cf;
-                            ss << CharTools::CopySign(cf, cs);
-                        }
-                        else
-                        {
-                            // No: Use the last sign seen, or the sign of the following char (the following char within the same word-boundary) (Important for replacing vocals within a word)
-                            const char charSignToUse = doHaveFollowingChar ? followingCharsSign : lastCharCharSign;
-                            ss << CharTools::CopySign(charSignToUse, cs);
-                        }
-                    }
-                }
+                out.append(str, pos, end - pos);
+                pos = end;
             }
+
+            return pos;
+        }
+
+        out.append(str, pos, posFound - pos);
+        out += sub;
+        pos = posFound + find.length();
+    }
+}
+
+Util::ReplacementTable::ReplacementTable(std::vector<Replacement> replacements)
+    : replacements(std::move(replacements))
+{
+    // Root node
+    nodes.emplace_back();
+
+    for (std::size_t r = 0; r < this->replacements.size(); r++)
+    {
+        const std::string& find = this->replacements[r].find;
+
+        // Empty findings would be found everywhere... ignore them, like ConditionalReplaceButKeepSigns does
+        if (find.length() == 0)
+            continue;
+
+        maxFindLength = std::max(maxFindLength, find.length());
+        isFirstChar[(unsigned char)CharTable::MakeLower(find[0])] = true;
+        isFirstChar[(unsigned char)CharTable::MakeUpper(find[0])] = true;
+
+        // Walk down the trie (case-insensitively), creating nodes as needed
+        std::size_t node = 0;
+        for (const char c : find)
+        {
+            const char lower = CharTable::MakeLower(c);
+            const auto child = std::find_if(nodes[node].children.begin(), nodes[node].children.end(), [lower](const auto& child) {
+                return child.first == lower;
+            });
+
+            if (child != nodes[node].children.end())
+                node = child->second;
             else
             {
-                // We do not have an occurrence... just insert the subsection found as is (next iteration will start behind it)
-                ss << foundInText;
+                nodes[node].children.emplace_back(lower, nodes.size());
+                node = nodes.size();
+                nodes.emplace_back();
             }
+        }
+
+        nodes[node].replacements.push_back(r);
+    }
 
-            // Advance i accordingly
-            i += foundInText.length()-1;
+    // Every node also gets to know the replacements ending above it.
+    // Children always come after their parents, so the parents' lists are complete by the time we get to them.
+    for (std::size_t node = 0; node < nodes.size(); node++)
+    {
+        for (const auto& child : nodes[node].children)
+        {
+            std::vector<std::size_t> merged;
+            std::merge(
+                    nodes[node].replacements.begin(), nodes[node].replacements.end(),
+                    nodes[child.second].replacements.begin(), nodes[child.second].replacements.end(),
+                    std::back_inserter(merged)
+            );
+            nodes[child.second].replacements = std::move(merged);
         }
-        else
+    }
+}
+
+Util::ReplacementTable::ReplacementTable(std::initializer_list<Replacement> replacements)
+    : ReplacementTable(std::vector<Replacement>(replacements))
+{
+}
+
+std::string Util::MultiReplaceButKeepSigns(const std::string& str, const ReplacementTable& table)
+{
+    std::string out;
+    out.reserve(str.length());
+
+    MultiReplaceButKeepSignsInto(str, 0, true, table, out);
+
+    return out;
+}
+
+std::size_t Util::MultiReplaceButKeepSignsInto(
+        const std::string& str,
+        std::size_t pos,
+        bool final,
+        const ReplacementTable& table,
+        std::string& out
+)
+{
+    // Where we have to stop, to leave the callbacks enough chars to look at
+    const std::size_t end =
+            final ? str.length() :
+            (str.length() >= table.maxFindLength + validatorLookahead) ? str.length() - table.maxFindLength - validatorLookahead + 1 :
+            0;
+
+    const std::string_view text(str);
+
+    // The callbacks want a string. Findings are short, and this buffer gets reused, so that doesn't allocate
+    std::string finding;
+
+    // What's found at an index: The replacement accepted there, and the length of its finding.
+    // If none got accepted, that's the length of the first finding. If there is none at all, it's 0.
+    struct Match {
+        const Replacement* replacement = nullptr;
+        std::size_t length = 0;
+    };
+
+    const auto matchAt = [&](const std::size_t at) {
+        if constexpr (Stats::enabled)
+            Stats::Count(Stats::candidates);
+
+        // Walk down the trie as far as the text goes along. Every replacement ending on the way there has been found
+        std::size_t node = 0;
+        for (std::size_t j = at; j < text.length(); j++)
+        {
+            const char lower = CharTable::MakeLower(text[j]);
+            const auto& children = table.nodes[node].children;
+            const auto child = std::find_if(children.begin(), children.end(), [lower](const auto& child) {
+                return child.first == lower;
+            });
+
+            if (child == children.end())
+                break;
+
+            node = child->second;
+        }
+
+        // Earlier replacements in the table take precedence
+        Match match;
+        for (const std::size_t r : table.nodes[node].replacements)
         {
-            // We do not have an occurrence... just insert the char as is
-            ss << str[i];
+            const Replacement& replacement = table.replacements[r];
+            const std::string_view foundInText = text.substr(at, replacement.find.length());
+
+            // Case-sensitive ones have to match exactly
+            if ((!replacement.keepSigns) && (foundInText != replacement.find))
+                continue;
+
+            if (match.length == 0)
+                match.length = foundInText.length();
+
+            if constexpr (Stats::enabled)
+                Stats::Count(Stats::validatorCalls);
+
+            // Ask the callback if we should replace this one
+            finding.assign(foundInText);
+            if ((!replacement.onlyIf) || (replacement.onlyIf(str, finding, at)))
+            {
+                if constexpr (Stats::enabled)
+                    Stats::Count(Stats::accepts);
+
+                match.replacement = &replacement;
+                match.length = foundInText.length();
+                break;
+            }
         }
+
+        return match;
+    };
+
+    // The match behind the last replacement, if that one had to look at it already. Then it's not looked for again
+    std::size_t aheadIndex = std::string::npos;
+    Match ahead;
+
+    std::size_t i = pos;
+    while (i < end)
+    {
+        // Skip ahead to the next char that could start an occurrence, and insert everything skipped as is
+        std::size_t next = i;
+        while ((next < end) && (!table.isFirstChar[(unsigned char)text[next]]))
+            next++;
+
+        out.append(text.data() + i, next - i);
+        i = next;
+
+        if (i == end)
+            break;
+
+        const Match match = (i == aheadIndex) ? ahead : matchAt(i);
+
+        // Nobody wanted to replace anything... just insert the first finding (or the char, if there is none) as is
+        if (match.replacement == nullptr)
+        {
+            const std::size_t keep = std::max<std::size_t>(match.length, 1);
+            out.append(text.data() + i, keep);
+            i += keep;
+            continue;
+        }
+
+        const Replacement& replacement = *match.replacement;
+        const std::string_view foundInText = text.substr(i, match.length);
+        const std::size_t behind = i + match.length;
+
+        if (!replacement.keepSigns)
+        {
+            out += replacement.sub;
+            i = behind;
+            continue;
+        }
+
+        // A sub longer than its finding takes the sign of the following char, and that's the char as it comes out of this scan.
+        // So if a replacement starts there, its sub's first char counts, just as if this replacement was done after all the others
+        char followingChar = (behind < text.length()) ? text[behind] : '\0';
+        if ((replacement.sub.length() > match.length) && (behind < text.length()) && (table.isFirstChar[(unsigned char)text[behind]]))
+        {
+            // Another block has to come first, to find what's there. Rare enough to ask this finding's callback again then
+            if (behind >= end)
+                break;
+
+            ahead = matchAt(behind);
+            aheadIndex = behind;
+
+            if ((ahead.replacement != nullptr) && (!ahead.replacement->sub.empty()))
+                followingChar = ahead.replacement->keepSigns ? CharTable::CopySign(text[behind], ahead.replacement->sub[0]) : ahead.replacement->sub[0];
+        }
+
+        AppendKeepingSigns(foundInText, replacement.sub, followingChar, out);
+        i = behind;
+    }
+
+    return i;
+}
+
+void Util::CharClasses::Reset(std::string_view str, std::size_t base)
+{
+    this->str = str;
+    this->base = base;
+
+    const std::size_t words = (str.length() - base + 63) / 64;
+    letters.resize(words);
+    vowels.resize(words);
+    uppers.resize(words);
+    ready.assign(words, false);
+}
+
+void Util::CharClasses::ClassifyWord(std::size_t word)
+{
+    Kernels::Classify(str.substr(base + 64 * word, 64), &letters[word], &vowels[word], &uppers[word]);
+    ready[word] = true;
+}
+
+Util::CharClasses& Util::ThreadCharClasses()
+{
+    thread_local CharClasses classes;
+    return classes;
+}
+
+std::uint64_t Util::Hash(std::string_view str)
+{
+    std::uint64_t hash = 0xCBF29CE484222325ull;
+    for (const char c : str)
+    {
+        hash ^= (unsigned char)c;
+        hash *= 0x100000001B3ull;
     }
 
-    return ss.str();
+    return hash;
+}
+
+bool Util::EqualsIgnoringCase(std::string_view text, std::string_view lowerFind)
+{
+    return Kernels::EqualsIgnoringCase(text, lowerFind);
+}
+
+void Util::AppendKeepingSigns(
+        std::string_view str,
+        const std::size_t index,
+        std::string_view finding,
+        std::string_view sub,
+        std::string& out
+)
+{
+    const std::size_t behind = index + finding.length();
+    AppendKeepingSigns(finding, sub, (behind < str.length()) ? str[behind] : '\0', out);
+}
+
+void Util::AppendKeepingSigns(
+        std::string_view finding,
+        std::string_view sub,
+        const char followingChar,
+        std::string& out
+)
+{
+    // We have three possible cases:
+    // 1: len(find) == len(sub), in this case we want to sync capitalization by index.
+    // 2: len(find) < len(sub), in this case we sync by index, BUT...
+    // 3: len(find) > len(sub): sync capitalization by index
+
+    // We want to sync capitalization by index
+    // This accounts for both cases: 1 and 3
+    if (finding.length() >= sub.length())
+    {
+        for (std::size_t j = 0; j < sub.length(); j++)
+        {
+            const char cf = finding[j];
+            const char cs = sub[j];
+
+            out += CharTable::CopySign(cf, cs);
+        }
+    }
+
+        // in this case we sync by index, BUT...
+    else if (finding.length() < sub.length())
+    {
+        char followingCharsSign = 0;
+        bool doHaveFollowingChar = false;
+        // Do we even have a following char, and is it a letter? ('\0' is none)
+        if (CharTable::IsLetter(followingChar))
+        {
+            // Copy its sign
+            followingCharsSign = followingChar;
+            doHaveFollowingChar = true;
+        }
+
+
+        char lastCharCharSign = 0;
+        for (std::size_t j = 0; j < sub.length(); j++)
+        {
+            const char cs = sub[j];
+
+            // Do we still have chars of 'find' left?
+            if (j < finding.length())
+            {
+                // Yes: Just copy the sign as is, and update the last sign seen
+                const char cf = finding[j];
+                lastCharCharSign = cf;
+                out += CharTable::CopySign(cf, cs);
+            }
+            else
+            {
+                // No: Use the last sign seen, or the sign of the following char (the following char within the same word-boundary) (Important for replacing vocals within a word)
+                const char charSignToUse = doHaveFollowingChar ? followingCharsSign : lastCharCharSign;
+                out += CharTable::CopySign(charSignToUse, cs);
+            }
+        }
+    }
 }
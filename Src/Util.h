@@ -2,11 +2,135 @@
 #define UWWWU_UTIL_H
 
 #include <string>
+#include <string_view>
+#include <vector>
 #include <functional>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
 #include <cstddef>
+#include <cstdint>
+#include "CharTable.h"
+#include "Stats.h"
+#include "Kernels.h"
 
 class Util {
 public:
+    //! Callback deciding whether a finding should be replaced. Gets the whole string, the finding as it appears in the string, and its index.
+    using Validator = std::function<bool(const std::string&, const std::string&, const std::size_t)>;
+
+    //! One entry of a replacement table for MultiReplaceButKeepSigns.
+    struct Replacement {
+        std::string find;
+        std::string sub;
+        //! Only replace if this says so. Empty means: replace always.
+        Validator onlyIf = nullptr;
+        //! If false, `find` is matched case-sensitively, and `sub` gets inserted as is (just like StringTools::Replace does).
+        bool keepSigns = true;
+    };
+
+    //! A bunch of replacements, compiled into a trie, so that they can all be looked for in a single scan.
+    class ReplacementTable {
+    public:
+        ReplacementTable(std::vector<Replacement> replacements);
+        ReplacementTable(std::initializer_list<Replacement> replacements);
+
+    private:
+        struct Node {
+            std::vector<std::pair<char, std::size_t>> children;
+            //! Indices of the replacements whose `find` ends at this node, or at any node above it. Ascending.
+            std::vector<std::size_t> replacements;
+        };
+
+        std::vector<Replacement> replacements;
+        std::vector<Node> nodes;
+        std::size_t maxFindLength = 0;
+        //! Whether a char can be the start of any finding at all
+        bool isFirstChar[256] = {};
+
+        friend class Util;
+    };
+
+    //! Chars of a string, classified into bitmaps (see Kernels::Classify), from index `base` on.
+    //! Words of 64 chars get classified as they're asked for, so a scan with few findings doesn't classify the whole string.
+    struct CharClasses {
+        std::string_view str;
+        std::size_t base = 0;
+        std::vector<std::uint64_t> letters;
+        std::vector<std::uint64_t> vowels;
+        std::vector<std::uint64_t> uppers;
+        //! Whether a word has been classified yet
+        std::vector<std::uint8_t> ready;
+
+        //! Starts over with `str`, from `base` on. Nothing is classified yet. Reuses the bitmaps' memory.
+        void Reset(std::string_view str, std::size_t base);
+
+        //! Makes sure the chars [begin, end) are classified. Both have to be within [base, str.length()], and `begin` below `end`.
+        void Prepare(std::size_t begin, std::size_t end) {
+            for (std::size_t word = (begin - base) / 64; word <= (end - 1 - base) / 64; word++)
+                if (!ready[word])
+                    ClassifyWord(word);
+        }
+
+    private:
+        void ClassifyWord(std::size_t word);
+    };
+
+    //! What a callback gets to know about a finding, if it takes one of these instead of the string, the finding and its index.
+    //! Chars are addressed by their offset from the start of the finding: -1 is the one before it, Next() the one after it.
+    //! It can tell about up to validatorLookbehind chars before the finding, and validatorLookahead chars after it.
+    //! Asking about any other char, or one that isn't there, is fine. It's not a letter, nor a vowel, nor uppercase, and it's '\0' in lowercase.
+    //! The chars around the finding get classified into `classes` (if they aren't yet), so every question but Lower() is a bit test.
+    class Finding {
+    public:
+        Finding(CharClasses& classes, std::size_t index, std::size_t length)
+            : classes(classes), index(index), length(length),
+              begin(std::max(classes.base, index - std::min(index, validatorLookbehind))),
+              end(std::min(classes.str.length(), index + length + validatorLookahead))
+        {
+            classes.Prepare(begin, end);
+        }
+
+        //! Index of the finding within the string
+        std::size_t Index() const { return index; }
+
+        std::size_t Length() const { return length; }
+
+        //! Offset of the `n`th char after the finding
+        std::ptrdiff_t Next(std::size_t n = 0) const { return static_cast<std::ptrdiff_t>(length + n); }
+
+        //! Whether there is a char at `offset`
+        bool Has(std::ptrdiff_t offset) const {
+            const std::ptrdiff_t at = static_cast<std::ptrdiff_t>(index) + offset;
+            return (at >= static_cast<std::ptrdiff_t>(begin)) && (at < static_cast<std::ptrdiff_t>(end));
+        }
+
+        bool IsLetter(std::ptrdiff_t offset) const { return Test(classes.letters, offset); }
+        bool IsVowel(std::ptrdiff_t offset) const { return Test(classes.vowels, offset); }
+        bool IsUpper(std::ptrdiff_t offset) const { return Test(classes.uppers, offset); }
+
+        //! The char at `offset`, in lowercase
+        char Lower(std::ptrdiff_t offset) const {
+            return Has(offset) ? CharTable::MakeLower(classes.str[index + offset]) : '\0';
+        }
+
+    private:
+        bool Test(const std::vector<std::uint64_t>& bits, std::ptrdiff_t offset) const {
+            if (!Has(offset))
+                return false;
+
+            const std::size_t bit = index + offset - classes.base;
+            return (bits[bit / 64] >> (bit % 64)) & 1;
+        }
+
+        const CharClasses& classes;
+        std::size_t index;
+        std::size_t length;
+        //! Chars [begin, end) are the ones it can tell about
+        std::size_t begin;
+        std::size_t end;
+    };
+
     //! Will replace all occurrences of a substring `find` in `str` with `sub`, but it will try to keep the characters signs.
     //! Like (pay attention to the capitalization):.
     //! ("Hello World", "hello", "hi") -> "Hi World".
@@ -18,9 +142,251 @@ public:
             std::string find,
             const std::string& sub,
             const std::function<bool(const std::string&, const std::string&, const std::size_t)>& onlyIf =
-                    [](auto, auto, auto) { return true; } // Default is: replace always
+                    [](const auto&, const auto&, auto) { return true; } // Default is: replace always
+    );
+
+    //! Same as above, but takes any callable as callback, instead of a std::function.
+    //! This way, the callback can be inlined into the scan, instead of being called indirectly on every finding.
+    //! The callback may also take a `const Finding&`, and ask that about the chars around the finding.
+    template<typename Callback>
+    static std::string ConditionalReplaceButKeepSigns(
+            const std::string& str,
+            std::string find,
+            const std::string& sub,
+            Callback&& onlyIf
+    );
+
+    //! Resumable flavour of ConditionalReplaceButKeepSigns, for text that arrives in blocks.
+    //! Starts scanning `str` at `pos` and appends the result to `out`. `find` has to be lowercase already.
+    //! Unless `final` is set, it stops as soon as a finding plus `validatorLookahead` chars would no longer fit into `str`,
+    //! and returns the position to resume at, once more text has been appended to `str`.
+    //! Callbacks get `str`, which isn't necessarily the whole text. See validatorLookbehind for how far they may look.
+    //! Nothing gets allocated, apart from growing `out`. So reusing `out` across calls makes a pass allocation-free.
+    static std::size_t ConditionalReplaceButKeepSignsInto(
+            const std::string& str,
+            std::size_t pos,
+            bool final,
+            std::string_view find,
+            std::string_view sub,
+            const std::function<bool(const std::string&, const std::string&, const std::size_t)>& onlyIf,
+            std::string& out
+    );
+
+    //! Same as above, but takes any callable as callback, instead of a std::function.
+    template<typename Callback>
+    static std::size_t ConditionalReplaceButKeepSignsInto(
+            const std::string& str,
+            std::size_t pos,
+            bool final,
+            std::string_view find,
+            std::string_view sub,
+            Callback&& onlyIf,
+            std::string& out
+    );
+
+    //! Same as StringTools::Replace (case-sensitive, no sign keeping), but resumable, just like ConditionalReplaceButKeepSignsInto.
+    static std::size_t ReplaceInto(
+            const std::string& str,
+            std::size_t pos,
+            bool final,
+            std::string_view find,
+            std::string_view sub,
+            std::string& out
+    );
+
+    //! Will replace all occurrences of all `find`-strings in `table` at once, in a single scan over `str`. Signs are kept just like in ConditionalReplaceButKeepSigns.
+    //! Scanning goes left to right. If multiple replacements are found at the same index, the first one in `table` that's accepted by its callback wins.
+    //! If none is accepted, the finding of the first one is kept as is. Either way, scanning continues behind that finding.
+    //! Replacements only ever see `str`, never what the others replaced. Except for one thing: A sub longer than its finding
+    //! takes the sign of the following char as it comes out, so that's the first char of the replacement there, if there is one.
+    static std::string MultiReplaceButKeepSigns(const std::string& str, const ReplacementTable& table);
+
+    //! Resumable flavour of MultiReplaceButKeepSigns, just like ConditionalReplaceButKeepSignsInto.
+    static std::size_t MultiReplaceButKeepSignsInto(
+            const std::string& str,
+            std::size_t pos,
+            bool final,
+            const ReplacementTable& table,
+            std::string& out
+    );
+
+    //! How many chars past the end of a finding a callback may look at, when called from a resumable replace.
+    static constexpr std::size_t validatorLookahead = 2;
+
+    //! How many chars before a finding a Finding can tell about.
+    //! Callbacks taking the string see all of `str`. From ConditionalReplaceButKeepSigns, that's the whole input. From a resumable replace,
+    //! such as a Cascade stage, it's only what has arrived so far, minus what's been dropped: Cascade::history chars before where the scan resumed.
+    //! So they may only rely on validatorLookbehind chars before the finding, and validatorLookahead after it. Looking any further
+    //! makes the outcome depend on how the text happens to be cut into blocks.
+    static constexpr std::size_t validatorLookbehind = 2;
+
+    //! Will hash `str` (64 bit FNV-1a). Unlike std::hash, this yields the same on every platform and standard library.
+    static std::uint64_t Hash(std::string_view str);
+
+    //! Counter-based pseudo random number generator: Returns the `counter`th number of the sequence identified by `key`.
+    //! There is no state to seed or to share. So each roll costs a few multiplications,
+    //! and doesn't depend on how many numbers were rolled before, or on which thread rolls it.
+    static std::uint64_t Random(std::uint64_t key, std::uint64_t counter) {
+        return Mix(Mix(key) + (counter + 1) * 0x9E3779B97F4A7C15ull);
+    }
+
+    //! Will check whether `text` equals `lowerFind`, ignoring the case of `text`. `lowerFind` has to be lowercase already.
+    static bool EqualsIgnoringCase(std::string_view text, std::string_view lowerFind);
+
+private:
+    //! SplitMix64's finalizer. Scrambles the bits of `z` thoroughly.
+    static std::uint64_t Mix(std::uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    //! This thread's bitmaps, for scans to classify into
+    static CharClasses& ThreadCharClasses();
+
+    //! Appends `sub` to `out`, taking over the signs of `finding`, which was found in `str` at `index`.
+    static void AppendKeepingSigns(
+            std::string_view str,
+            const std::size_t index,
+            std::string_view finding,
+            std::string_view sub,
+            std::string& out
+    );
+
+    //! Same as above, but `followingChar` is the char following the finding, or '\0' if there is none.
+    static void AppendKeepingSigns(
+            std::string_view finding,
+            std::string_view sub,
+            char followingChar,
+            std::string& out
     );
 };
 
+template<typename Callback>
+std::string Util::ConditionalReplaceButKeepSigns(
+        const std::string& str,
+        std::string find,
+        const std::string& sub,
+        Callback&& onlyIf
+)
+{
+    // Quick accepts-and rejects
+    if (str.length() == 0)
+        return "";
+    else if (find.length() == 0)
+        return str;
+
+    std::string out;
+    out.reserve(str.length());
+
+    // Better safe than sorry
+    for (char& c : find)
+        c = CharTable::MakeLower(c);
+
+    ConditionalReplaceButKeepSignsInto(str, 0, true, find, sub, onlyIf, out);
+
+    return out;
+}
+
+template<typename Callback>
+std::size_t Util::ConditionalReplaceButKeepSignsInto(
+        const std::string& str,
+        std::size_t pos,
+        bool final,
+        std::string_view find,
+        std::string_view sub,
+        Callback&& onlyIf,
+        std::string& out
+)
+{
+    // Nothing to find? Just pass everything through
+    if (find.length() == 0)
+    {
+        out.append(str, pos, std::string::npos);
+        return str.length();
+    }
+
+    // Where we have to stop, to leave the callback enough chars to look at
+    const std::size_t end =
+            final ? str.length() :
+            (str.length() >= find.length() + validatorLookahead) ? str.length() - find.length() - validatorLookahead + 1 :
+            0;
+
+    const std::string_view text(str);
+
+    // The callback wants a string. Findings are short, and this buffer gets reused, so that doesn't allocate
+    std::string finding;
+
+    // ...or it wants a Finding. Then the text gets classified, around whatever there is to ask about
+    constexpr bool takesFinding = std::is_invocable_r_v<bool, Callback&, const Finding&>;
+    CharClasses* classes = nullptr;
+
+    std::size_t i = pos;
+    while (i < end)
+    {
+        // Skip ahead to the next chars that could start an occurrence, and insert everything skipped as is, in one go.
+        // Most of a text can't, so this is where most of the time goes. So it's vectorized.
+        const std::size_t next = Kernels::FindCandidate(text, i, end, find);
+
+        out.append(text.data() + i, next - i);
+        i = next;
+
+        if (i == end)
+            break;
+
+        if constexpr (Stats::enabled)
+            Stats::Count(Stats::candidates);
+
+        const std::string_view foundInText = text.substr(i, find.length());
+        if (Kernels::EqualsIgnoringCase(foundInText, find))
+        {
+            if constexpr (Stats::enabled)
+                Stats::Count(Stats::validatorCalls);
+
+            // Ask the callback if we should replace this one
+            bool replace;
+            if constexpr (takesFinding)
+            {
+                if (classes == nullptr)
+                {
+                    classes = &ThreadCharClasses();
+                    classes->Reset(text, pos - std::min(pos, validatorLookbehind));
+                }
+
+                replace = onlyIf(Finding(*classes, i, foundInText.length()));
+            }
+            else
+            {
+                finding.assign(foundInText);
+                replace = onlyIf(str, finding, i);
+            }
+
+            if (replace)
+            {
+                if constexpr (Stats::enabled)
+                    Stats::Count(Stats::accepts);
+
+                // Here we've found our occurrence...
+                AppendKeepingSigns(text, i, foundInText, sub, out);
+            }
+            else
+            {
+                // We do not have an occurrence... just insert the subsection found as is (next iteration will start behind it)
+                out += foundInText;
+            }
+
+            // Advance i accordingly
+            i += foundInText.length();
+        }
+        else
+        {
+            // We do not have an occurrence... just insert the char as is
+            out += text[i];
+            i++;
+        }
+    }
+
+    return i;
+}
 
 #endif //UWWWU_UTIL_H
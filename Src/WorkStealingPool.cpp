@@ -0,0 +1,171 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+namespace {
+    //! Whether this thread is currently working on a job of any pool
+    thread_local bool isWorking = false;
+}
+
+WorkStealingPool::WorkStealingPool(std::size_t threads)
+{
+    threads = std::max<std::size_t>(threads, 1);
+
+    for (std::size_t s = 0; s < threads; s++)
+        slots.push_back(std::make_unique<Slot>());
+
+    for (std::size_t s = 1; s < threads; s++)
+        workers.emplace_back(&WorkStealingPool::WorkerLoop, this, s);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+std::size_t WorkStealingPool::Size() const
+{
+    return slots.size();
+}
+
+WorkStealingPool& WorkStealingPool::Shared()
+{
+    static WorkStealingPool pool;
+    return pool;
+}
+
+void WorkStealingPool::ForEach(std::size_t count, const std::function<void(std::size_t)>& task)
+{
+    if (count == 0)
+        return;
+
+    // Nested jobs (and pools without workers) just get run on the spot
+    if ((isWorking) || (workers.empty()) || (count == 1))
+    {
+        for (std::size_t i = 0; i < count; i++)
+            task(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> job(jobMutex);
+
+    // Everyone starts out with an equal share
+    for (std::size_t s = 0; s < slots.size(); s++)
+    {
+        std::lock_guard<std::mutex> lock(slots[s]->mutex);
+        slots[s]->begin = count * s / slots.size();
+        slots[s]->end = count * (s + 1) / slots.size();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->task = &task;
+        error = nullptr;
+        busyWorkers = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    // Help out
+    Work(0);
+
+    // Wait for the workers to finish what they took
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]() { return busyWorkers == 0; });
+    this->task = nullptr;
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void WorkStealingPool::WorkerLoop(std::size_t slot)
+{
+    std::size_t seenGeneration = 0;
+    while (true)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait(lock, [&]() { return (stopping) || (generation != seenGeneration); });
+        if (stopping)
+            return;
+        seenGeneration = generation;
+        lock.unlock();
+
+        Work(slot);
+
+        lock.lock();
+        if (--busyWorkers == 0)
+            finished.notify_all();
+    }
+}
+
+void WorkStealingPool::Work(std::size_t slot)
+{
+    isWorking = true;
+
+    std::size_t index;
+    while ((PopOwn(slot, index)) || (Steal(slot, index)))
+    {
+        try
+        {
+            (*task)(index);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+
+    isWorking = false;
+}
+
+bool WorkStealingPool::PopOwn(std::size_t slot, std::size_t& index)
+{
+    Slot& own = *slots[slot];
+    std::lock_guard<std::mutex> lock(own.mutex);
+
+    if (own.begin == own.end)
+        return false;
+
+    index = own.begin++;
+    return true;
+}
+
+bool WorkStealingPool::Steal(std::size_t slot, std::size_t& index)
+{
+    // Look around, starting with the neighbour, so that not everyone goes for the same victim
+    for (std::size_t offset = 1; offset < slots.size(); offset++)
+    {
+        Slot& victim = *slots[(slot + offset) % slots.size()];
+
+        std::size_t begin;
+        std::size_t end;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.begin == victim.end)
+                continue;
+
+            // Take the back half of what's left (rounded up)
+            begin = victim.begin + (victim.end - victim.begin) / 2;
+            end = victim.end;
+            victim.end = begin;
+        }
+
+        // Keep the first one to work on right away, and the rest for later (and for others to steal)
+        Slot& own = *slots[slot];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        index = begin;
+        own.begin = begin + 1;
+        own.end = end;
+        return true;
+    }
+
+    return false;
+}
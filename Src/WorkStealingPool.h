@@ -0,0 +1,67 @@
+#ifndef UWWWU_WORKSTEALINGPOOL_H
+#define UWWWU_WORKSTEALINGPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//! A pool of worker threads, for spreading work of very uneven size over all cores.
+//! Every thread starts out with its own share of the work. Once done with it, it steals half of what's left of someone else's.
+//! The threads stick around between jobs, so there is no thread startup to pay per job.
+class WorkStealingPool {
+public:
+    //! `threads` is the total number of threads working on a job, including the one calling ForEach.
+    explicit WorkStealingPool(std::size_t threads = std::thread::hardware_concurrency());
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    //! Calls `task(i)` for every i in [0, count), spread over the pool, and returns once all calls returned.
+    //! The calling thread helps out. If a call throws, the first exception gets rethrown here, once all calls are done.
+    //! Jobs from multiple threads are run one after another. Calling ForEach from within a task just runs the inner job on the spot.
+    void ForEach(std::size_t count, const std::function<void(std::size_t)>& task);
+
+    //! Total number of threads working on a job, including the one calling ForEach.
+    std::size_t Size() const;
+
+    //! Pool for everyone who doesn't bring their own. Gets created on first use, with one thread per core.
+    static WorkStealingPool& Shared();
+
+private:
+    //! Indices [begin, end) of the current job a thread still has to do
+    struct Slot {
+        std::mutex mutex;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+    };
+
+    void WorkerLoop(std::size_t slot);
+    void Work(std::size_t slot);
+    bool PopOwn(std::size_t slot, std::size_t& index);
+    bool Steal(std::size_t slot, std::size_t& index);
+
+    //! Slot 0 is the calling thread's, the others belong to the workers
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::vector<std::thread> workers;
+
+    //! Only one job at a time
+    std::mutex jobMutex;
+
+    //! Guards everything below
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::size_t generation = 0;
+    std::size_t busyWorkers = 0;
+    bool stopping = false;
+    const std::function<void(std::size_t)>* task = nullptr;
+    std::exception_ptr error;
+};
+
+#endif //UWWWU_WORKSTEALINGPOOL_H
@@ -1,25 +1,260 @@
-#include <iostream>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <memory>
+#include <stdexcept>
 #include "LibUwu.h"
+#include "Pipeline.h"
+#include "FileTransform.h"
+#include "StdioStreamBuf.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+// No <iostream> in here, on purpose: Most runs uwuify a single message from argv,
+// and shouldn't have to pay for constructing the standard streams (and their locales) on startup.
+
+namespace {
+    //! Writes all of `str` to stdout, straight through to the fd, where there is one.
+    //! Picks up where short writes, and writes interrupted by a signal, left off
+    void WriteOut(const std::string& str) {
+#if defined(__unix__) || defined(__APPLE__)
+        std::size_t written = 0;
+        while (written < str.length())
+        {
+            const ssize_t count = write(STDOUT_FILENO, str.data() + written, str.length() - written);
+            if ((count < 0) && (errno == EINTR))
+                continue;
+            if (count <= 0)
+                return;
+            written += static_cast<std::size_t>(count);
+        }
+#else
+        std::fwrite(str.data(), 1, str.length(), stdout);
+        std::fflush(stdout);
+#endif
+    }
+
+    //! More threads than this are surely a typo
+    constexpr std::size_t maxJobs = 4096;
+
+    //! Reads the N of "-j N" into `jobs`. Returns false, if it's anything but a number from 1 to maxJobs
+    bool ParseJobs(const char* arg, std::size_t& jobs) {
+        // strtoul would happily wrap "-3" around, and skip whitespace
+        if ((*arg < '0') || (*arg > '9'))
+            return false;
+
+        char* end = nullptr;
+        errno = 0;
+        const unsigned long value = std::strtoul(arg, &end, 10);
+        if ((errno != 0) || (*end != '\0') || (value < 1) || (value > maxJobs))
+            return false;
+
+        jobs = static_cast<std::size_t>(value);
+        return true;
+    }
+
+    //! Has the stats printed to stderr, whenever the process exits
+    void EnableStats() {
+        if constexpr (!Stats::enabled)
+        {
+            // Which kernels ran is still worth knowing
+            std::fputs("--stats: This build doesn't count anything. Rebuild with -DUWWWU_STATS=ON\n", stderr);
+            std::atexit([]() { std::fprintf(stderr, "kernels: %s\n", Kernels::LevelName(Kernels::ActiveLevel())); });
+            return;
+        }
+
+        // Statics get destroyed in reverse order of construction, mixed with atexit handlers.
+        // So construct the rules before registering the handler, for them to still be around by then.
+        UwuRules();
+        std::atexit([]() { PrintUwuStats(stderr); });
+    }
+}
 
 int main(int argc, char** argv) {
 
+    // Options go first. "-j N" uwuifies on N threads, "-i in -o out" uwuifies a whole file,
+    // "--stats" prints how often each rule fired, and which kernels ran, on exit.
+    // "--latency" prints latency percentiles on exit, "--slow-log path" writes the slowest inputs to `path`.
+    // "--kernels level" forces the kernels onto scalar, sse4.2, avx2 or avx512bw, just like the UWWWU_KERNELS environment variable
+    // Everything from the first word that isn't an option on gets uwuified. So does everything after "--",
+    // which is the way to uwuify text that starts with one of the options, such as "-j".
+    std::size_t jobs = 0;
+    std::string inPath;
+    std::string outPath;
+    bool printLatency = false;
+    std::string slowLogPath;
+    int firstArg = 1;
+    while (firstArg < argc)
+    {
+        if ((std::strcmp(argv[firstArg], "-j") == 0) && (firstArg + 1 < argc))
+        {
+            if (!ParseJobs(argv[firstArg + 1], jobs))
+            {
+                std::fprintf(stderr, "-j: Expected a number of threads from 1 to %zu, got %s\n", maxJobs, argv[firstArg + 1]);
+                return 1;
+            }
+            firstArg += 2;
+        }
+        else if ((std::strcmp(argv[firstArg], "-i") == 0) && (firstArg + 1 < argc))
+        {
+            inPath = argv[firstArg + 1];
+            firstArg += 2;
+        }
+        else if ((std::strcmp(argv[firstArg], "-o") == 0) && (firstArg + 1 < argc))
+        {
+            outPath = argv[firstArg + 1];
+            firstArg += 2;
+        }
+        else if (std::strcmp(argv[firstArg], "--stats") == 0)
+        {
+            EnableStats();
+            firstArg++;
+        }
+        else if ((std::strcmp(argv[firstArg], "--kernels") == 0) && (firstArg + 1 < argc))
+        {
+            Kernels::Level level;
+            if (!Kernels::ParseLevel(argv[firstArg + 1], level))
+            {
+                std::fprintf(stderr, "--kernels: Unknown level %s. Try scalar, sse4.2, avx2 or avx512bw\n", argv[firstArg + 1]);
+                return 1;
+            }
+            if (!Kernels::UseLevel(level))
+            {
+                std::fprintf(stderr, "--kernels: This CPU can't do %s. The best it can do is %s\n", argv[firstArg + 1], Kernels::LevelName(Kernels::BestLevel()));
+                return 1;
+            }
+            firstArg += 2;
+        }
+        else if (std::strcmp(argv[firstArg], "--latency") == 0)
+        {
+            printLatency = true;
+            firstArg++;
+        }
+        else if ((std::strcmp(argv[firstArg], "--slow-log") == 0) && (firstArg + 1 < argc))
+        {
+            slowLogPath = argv[firstArg + 1];
+            firstArg += 2;
+        }
+        else if (std::strcmp(argv[firstArg], "--") == 0)
+        {
+            firstArg++;
+            break;
+        }
+        else
+            break;
+    }
+
+    // Time every MakeUwu, and report on the way out of here
+    std::unique_ptr<LatencyRecorder> latency;
+    if ((printLatency) || (!slowLogPath.empty()))
+    {
+        latency = std::make_unique<LatencyRecorder>();
+        LatencyRecorder::Install(latency.get());
+    }
+    struct Report {
+        const std::unique_ptr<LatencyRecorder>& latency;
+        bool print;
+        const std::string& slowLogPath;
+
+        ~Report() {
+            if (!latency)
+                return;
+
+            LatencyRecorder::Install(nullptr);
+            if (print)
+                latency->PrintReport(stderr);
+
+            if (!slowLogPath.empty())
+            {
+                if (std::FILE* file = std::fopen(slowLogPath.c_str(), "w"))
+                {
+                    latency->WriteSlowLog(file);
+                    std::fclose(file);
+                }
+                else
+                    std::fprintf(stderr, "Can't write slow-log %s\n", slowLogPath.c_str());
+            }
+        }
+    } report{ latency, printLatency, slowLogPath };
+
+    // We have files. Map them, and uwuifie all lines at once
+    if ((!inPath.empty()) || (!outPath.empty()))
+    {
+        if ((inPath.empty()) || (outPath.empty()))
+        {
+            std::fputs("Usage: Uwwwu [-j N] -i <input file> -o <output file>\n", stderr);
+            return 1;
+        }
+
+        // -j N gets its own pool, else every core gets to help
+        std::unique_ptr<WorkStealingPool> pool;
+        if (jobs > 0)
+            pool = std::make_unique<WorkStealingPool>(jobs);
+
+        try
+        {
+            FileTransform(
+                    [](std::string_view line, std::string& out) { MakeUwu(line, out); },
+                    pool ? *pool : WorkStealingPool::Shared()
+            ).Run(inPath, outPath);
+        }
+        catch (const std::runtime_error& e)
+        {
+            std::fprintf(stderr, "%s\n", e.what());
+            return 1;
+        }
+    }
+
     // We have arguments. Uwwuifie these instead
-    if (argc > 1)
+    else if (argc > firstArg)
     {
+        // A single message doesn't have lines to spread over threads
+        if (jobs > 0)
+        {
+            std::fputs("-j: Only works on files and stdin. Drop it, or pipe the text in instead\n", stderr);
+            return 1;
+        }
+
         // We have to put the args together first, because some replace-rules cross word-borders
-        std::stringstream  ss;
-        for (std::size_t i = 1; i < argc; i++)
-            ss << std::string(argv[i]) + " ";
+        std::string args;
+        for (int i = firstArg; i < argc; i++)
+        {
+            args += argv[i];
+            args += ' ';
+        }
 
-        std::cout << MakeUwu(ss.str()) << std::endl;
+        std::string uwu;
+        uwu.reserve(2 * args.length() + 1);
+        MakeUwu(args, uwu);
+        uwu += '\n';
+
+        WriteOut(uwu);
     }
 
     // Else, be prepared to get __piped__
     else
     {
-        std::string buf;
-        while (std::getline(std::cin, buf))
-            std::cout << MakeUwu(buf) << std::endl;
+        StdioStreamBuf inBuffer(stdin);
+        StdioStreamBuf outBuffer(stdout);
+        std::istream in(&inBuffer);
+        std::ostream out(&outBuffer);
+
+        // ...by the gigabyte, on multiple threads
+        if (jobs > 0)
+            Pipeline([](const std::string& line) { return MakeUwu(line); }, jobs).Run(in, out);
+
+        // ...line by line, as they come in
+        else
+        {
+            std::string buf;
+            while (std::getline(in, buf))
+                out << MakeUwu(buf) << std::endl;
+        }
     }
 
     return 0;
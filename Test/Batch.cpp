@@ -0,0 +1,82 @@
+#include <LibUwu.h>
+#include "Catch2.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+    // Lots of short lines, with a few huge ones in between
+    std::vector<std::string> MakeStrings() {
+        std::vector<std::string> strings;
+        for (std::size_t i = 0; i < 500; i++)
+        {
+            std::string s = "Line " + std::to_string(i) + ": Hello, larry! thank you, you're good :) ";
+            if (i % 97 == 0)
+                while (s.length() < 50000)
+                    s += s;
+            else if (i % 5 == 0)
+                s.clear();
+
+            strings.push_back(s);
+        }
+
+        return strings;
+    }
+}
+
+// Tests that a batch comes out the same as uwu'ing every string on its own
+TEST_CASE(__FILE__"/SameAsOneByOne", "[]")
+{
+    // Setup
+    const std::vector<std::string> strings = MakeStrings();
+    const std::vector<std::string_view> views(strings.begin(), strings.end());
+
+    std::vector<std::string> expected;
+    for (const std::string& s : strings)
+        expected.push_back(MakeUwu(s, 42));
+
+    // Exercise
+    const std::vector<std::string> result = MakeUwuBatch(views, 42);
+
+    // Verify
+    REQUIRE(result == expected);
+}
+
+// Tests that writing into a caller's buffer replaces its old contents, and that the buffer can be reused
+TEST_CASE(__FILE__"/IntoCallerBuffer", "[]")
+{
+    // Setup
+    const std::vector<std::string> strings = MakeStrings();
+    const std::vector<std::string_view> views(strings.begin(), strings.end());
+    std::vector<std::string> buffer(strings.size(), "leftovers");
+
+    // Exercise
+    MakeUwuBatch(views, buffer);
+    MakeUwuBatch(views, buffer);
+
+    // Verify
+    for (std::size_t i = 0; i < strings.size(); i++)
+        REQUIRE(buffer[i] == MakeUwu(strings[i]));
+}
+
+// Tests that a batch on a pool of its own comes out the same as on the shared one
+TEST_CASE(__FILE__"/OwnPool", "[]")
+{
+    // Setup
+    const std::vector<std::string> strings = MakeStrings();
+    const std::vector<std::string_view> views(strings.begin(), strings.end());
+    std::vector<std::string> buffer(strings.size());
+    WorkStealingPool pool(3);
+
+    // Exercise
+    MakeUwuBatch(views, buffer, 7, pool);
+
+    // Verify
+    REQUIRE(buffer == MakeUwuBatch(views, 7));
+}
+
+// Tests that an empty batch yields nothing
+TEST_CASE(__FILE__"/Empty", "[]")
+{
+    REQUIRE(MakeUwuBatch(std::span<const std::string_view>()).empty());
+}
@@ -0,0 +1,110 @@
+#include <Cascade.h>
+#include <Util.h>
+#include <StringTools.h>
+#include "Catch2.h"
+
+namespace {
+    // A bunch of text, long enough to span quite a few blocks
+    const std::string text =
+            "Thank you, Rarely a kernel-panic. ThAnK yOu for the nine lovely llamas! "
+            "Larry trips up the river, and none of the emacs users cared. :) :D :-) ^^ c++ C++ c++:) C++Th "
+            "one ONE oNe nnn rrr lll yyy TH tH th. Well well WELL, hello there dear, good job!";
+
+    // Validator that looks at all the surrounding chars it may look at
+    bool LooksAround(const std::string& original, const std::string& finding, const std::size_t index) {
+        if (original.length() == finding.length())
+            return true;
+        if (index + finding.length() + 1 >= original.length())
+            return false;
+        if (index == 0)
+            return true;
+
+        return (original[index - 1] != ' ') || (original[index + finding.length() + 1] == 'e');
+    }
+}
+
+// Tests that a cascade without stages returns its input as is
+TEST_CASE(__FILE__"/NoStagesChangesNothing", "[]")
+{
+    // Exercise
+    const std::string result = Cascade().Run(text);
+
+    // Verify
+    REQUIRE(result == text);
+}
+
+// Tests that an empty input string returns an empty string
+TEST_CASE(__FILE__"/EmptyInputString", "[]")
+{
+    // Setup
+    const Cascade cascade = Cascade()
+            .Then(Cascade::ReplaceButKeepSigns("th", "tw"))
+            .Then(Cascade::Replace(":)", "UwU"));
+
+    // Exercise
+    const std::string result = cascade.Run("");
+
+    // Verify
+    REQUIRE(result.empty());
+}
+
+// Tests that a cascade yields exactly what running the passes one after another yields, no matter how small the blocks are
+TEST_CASE(__FILE__"/SameAsSequentialPasses", "[]")
+{
+    // Setup
+    std::string expected = text;
+    expected = Util::ConditionalReplaceButKeepSigns(expected, "th", "tw");
+    expected = Util::ConditionalReplaceButKeepSigns(expected, "twank you", "you're twe best", LooksAround);
+    expected = Util::ConditionalReplaceButKeepSigns(expected, "n", "ny", LooksAround);
+    expected = Util::ConditionalReplaceButKeepSigns(expected, "er", "a", LooksAround);
+    expected = StringTools::Replace(expected, ":)", "UwU :D");
+    expected = StringTools::Replace(expected, ":D", ":3");
+    expected = Util::ConditionalReplaceButKeepSigns(expected, "l", "w", LooksAround);
+
+    for (const std::size_t blockSize : {1, 2, 3, 7, 64, 4096})
+    {
+        SECTION(std::to_string(blockSize))
+        {
+            const Cascade cascade = Cascade(blockSize)
+                    .Then(Cascade::ReplaceButKeepSigns("th", "tw"))
+                    .Then(Cascade::ReplaceButKeepSigns("twank you", "you're twe best", LooksAround))
+                    .Then(Cascade::ReplaceButKeepSigns("n", "ny", LooksAround))
+                    .Then(Cascade::ReplaceButKeepSigns("er", "a", LooksAround))
+                    .Then(Cascade::Replace(":)", "UwU :D"))
+                    .Then(Cascade::Replace(":D", ":3"))
+                    .Then(Cascade::ReplaceButKeepSigns("l", "w", LooksAround));
+
+            // Exercise
+            const std::string result = cascade.Run(text);
+
+            // Verify
+            REQUIRE(result == expected);
+        }
+    }
+}
+
+// Tests that a multi-replace stage yields exactly what MultiReplaceButKeepSigns yields, no matter how small the blocks are
+TEST_CASE(__FILE__"/MultiReplaceSameAsWholeString", "[]")
+{
+    // Setup
+    const Util::ReplacementTable table = {
+        { ":)", "UwU :3", nullptr, false },
+        { "th", "tw" },
+        { "twank you", "you're twe best", LooksAround },
+        { "n", "ny", LooksAround },
+        { "c++", "c++ (rust is hella cutewr btw ^^)" }
+    };
+    const std::string expected = Util::MultiReplaceButKeepSigns(text, table);
+
+    for (const std::size_t blockSize : {1, 2, 3, 7, 64, 4096})
+    {
+        SECTION(std::to_string(blockSize))
+        {
+            // Exercise
+            const std::string result = Cascade(blockSize).Then(Cascade::MultiReplaceButKeepSigns(table)).Run(text);
+
+            // Verify
+            REQUIRE(result == expected);
+        }
+    }
+}
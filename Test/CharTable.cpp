@@ -0,0 +1,26 @@
+#include <CharTable.h>
+#include <CharTools.h>
+#include "Catch2.h"
+
+// Tests that the tables agree with CharTools on every single char
+TEST_CASE(__FILE__"/SameAsCharTools", "[]")
+{
+    for (int i = 0; i < 256; i++)
+    {
+        const char c = static_cast<char>(i);
+
+        REQUIRE(CharTable::IsLetter(c) == CharTools::IsLetter(c));
+        REQUIRE(CharTable::IsVowel(c) == CharTools::IsVowel(c));
+        REQUIRE(CharTable::IsUpper(c) == CharTools::IsUpper(c));
+        REQUIRE(CharTable::MakeLower(c) == CharTools::MakeLower(c));
+        REQUIRE(CharTable::MakeUpper(c) == CharTools::MakeUpper(c));
+    }
+}
+
+// Tests that the branchless CopySign agrees with CharTools on every pair of chars
+TEST_CASE(__FILE__"/CopySignSameAsCharTools", "[]")
+{
+    for (int sign = 0; sign < 256; sign++)
+        for (int c = 0; c < 256; c++)
+            REQUIRE(CharTable::CopySign(static_cast<char>(sign), static_cast<char>(c)) == CharTools::CopySign(static_cast<char>(sign), static_cast<char>(c)));
+}
@@ -0,0 +1,36 @@
+#include <LibUwu.h>
+#include <Corpus.h>
+#include "Catch2.h"
+#include "Timing.h"
+#include <vector>
+
+// Tests that no input, however mean, makes the cost per byte grow with the input's length.
+// One pathological message may cost a constant factor more than a nice one, but never seconds more.
+// Times it, as that's what catches everything: Buffering, validators rescanning the string, rehashing... not just what Stats counts.
+// 64 times the input may cost 8 times as much per byte, to stay clear of noise. Quadratic cost would make that 64 times.
+TEST_CASE(__FILE__"/AdversarialInputsCostLinearTime", "[]")
+{
+    // Setup
+    const std::vector<CorpusGenerator::AdversarialInput> small = CorpusGenerator::Adversarial(1 << 10);
+    const std::vector<CorpusGenerator::AdversarialInput> large = CorpusGenerator::Adversarial(1 << 16);
+
+    for (std::size_t i = 0; i < small.size(); i++)
+    {
+        // Exercise
+        const double growth = CostGrowth(small[i].text, large[i].text);
+
+        // Verify
+        INFO(small[i].name << ": " << growth << " times the cost per byte");
+        REQUIRE(growth < 8);
+    }
+}
+
+// Tests that no input makes the output grow by more than a constant factor
+TEST_CASE(__FILE__"/AdversarialInputsGrowLinearly", "[]")
+{
+    for (const CorpusGenerator::AdversarialInput& input : CorpusGenerator::Adversarial(1 << 12))
+    {
+        INFO(input.name);
+        REQUIRE(MakeUwu(input.text).length() < input.text.length() * 16);
+    }
+}
@@ -201,3 +201,59 @@ TEST_CASE(__FILE__"/Original-value_on_callback_is_correct", "[]")
             }
     );
 }
+
+// Tests that the resumable flavour appends to the output buffer it's given, instead of replacing its contents
+TEST_CASE(__FILE__"/Into_AppendsToOutput", "[]")
+{
+    // Setup
+    const std::string in = "Hello Alice, lowercase alice, WTF ALICE?!";
+    std::string out = "Prefix: ";
+    const std::string expected = "Prefix: Hello Bob, lowercase bob, WTF BOB?!";
+
+    // Exercise
+    const std::size_t pos = Util::ConditionalReplaceButKeepSignsInto(in, 0, true, "alice", "bob", [](auto, auto, auto) { return true; }, out);
+
+    // Verify
+    REQUIRE(out == expected);
+    REQUIRE(pos == in.length());
+}
+
+// Tests that the case-insensitive comparison only ignores the case of letters
+TEST_CASE(__FILE__"/EqualsIgnoringCase", "[]")
+{
+    REQUIRE(Util::EqualsIgnoringCase("BaNaNa", "banana"));
+    REQUIRE(Util::EqualsIgnoringCase("c++", "c++"));
+    REQUIRE(Util::EqualsIgnoringCase("", ""));
+    REQUIRE_FALSE(Util::EqualsIgnoringCase("BaNaN", "banana"));
+    REQUIRE_FALSE(Util::EqualsIgnoringCase("banana", "BANANA"));
+    REQUIRE_FALSE(Util::EqualsIgnoringCase("[", "{"));
+}
+
+// Tests that a callback taking a Finding gets told about the chars around the finding, and about chars that aren't there
+TEST_CASE(__FILE__"/FindingCallback", "[]")
+{
+    // Setup
+    const std::string in = "Tom: to me, TO us, to";
+    std::string seen;
+
+    // Exercise
+    const std::string result = Util::ConditionalReplaceButKeepSigns(
+            in,
+            "to",
+            "tu",
+            [&seen](const Util::Finding& finding) {
+                seen += std::to_string(finding.Index()) + (finding.Has(-1) ? "" : "^") + (finding.Has(finding.Next()) ? "" : "$") + " ";
+
+                // Not there: Neither letter, nor vowel, nor uppercase
+                REQUIRE_FALSE(finding.IsLetter(-100));
+                REQUIRE(finding.Lower(1000) == '\0');
+
+                // Only whole words whose next char is not uppercase
+                return (!finding.IsLetter(-1)) && (!finding.IsLetter(finding.Next())) && (!finding.IsUpper(finding.Next()));
+            }
+    );
+
+    // Verify
+    REQUIRE(seen == "0^ 5 12 19$ ");
+    REQUIRE(result == "Tom: tu me, TU us, tu");
+}
@@ -0,0 +1,73 @@
+#include <Corpus.h>
+#include <LibUwu.h>
+#include "Catch2.h"
+#include <algorithm>
+
+// Tests that the same options always make up the same text, and other seeds make up another
+TEST_CASE(__FILE__"/Deterministic", "[]")
+{
+    // Exercise
+    const std::string a = CorpusGenerator({ .seed = 1 }).Text(10000);
+    const std::string b = CorpusGenerator({ .seed = 1 }).Text(10000);
+    const std::string c = CorpusGenerator({ .seed = 2 }).Text(10000);
+
+    // Verify
+    REQUIRE(a.length() == 10000);
+    REQUIRE(a == b);
+    REQUIRE(a != c);
+}
+
+// Tests that filler text doesn't trigger any rule, so that the trigger density really is under control
+TEST_CASE(__FILE__"/FillerTriggersNothing", "[]")
+{
+    // Setup
+    const std::vector<std::string> lines = CorpusGenerator({
+        .seed = 3,
+        .triggerDensity = 0,
+        .punctuationDensity = 0,
+        .emoticonDensity = 0
+    }).Lines(500);
+
+    // Exercise, Verify
+    for (const std::string& line : lines)
+        REQUIRE(MakeUwu(line) == line);
+}
+
+// Tests that trigger words do trigger rules
+TEST_CASE(__FILE__"/TriggersTrigger", "[]")
+{
+    // Setup
+    const std::string text = CorpusGenerator({ .seed = 4, .triggerDensity = 1 }).Text(10000);
+
+    // Exercise
+    const std::string result = MakeUwu(text);
+
+    // Verify
+    REQUIRE(result.length() > text.length() + text.length() / 10);
+}
+
+// Tests that line lengths stay within bounds, and are spread out
+TEST_CASE(__FILE__"/LineLengths", "[]")
+{
+    // Setup
+    const std::vector<std::string> lines = CorpusGenerator({ .seed = 5, .meanWordsPerLine = 10, .maxWordsPerLine = 50 }).Lines(2000);
+
+    // Exercise
+    std::size_t minWords = 1000;
+    std::size_t maxWords = 0;
+    std::size_t totalWords = 0;
+    for (const std::string& line : lines)
+    {
+        const std::size_t words = std::count(line.begin(), line.end(), ' ') + 1;
+        minWords = std::min(minWords, words);
+        maxWords = std::max(maxWords, words);
+        totalWords += words;
+    }
+
+    // Verify
+    REQUIRE(minWords >= 1);
+    REQUIRE(maxWords <= 50 + 50); // "thank you" counts twice
+    REQUIRE(maxWords > 30);
+    REQUIRE(totalWords / lines.size() >= 8);
+    REQUIRE(totalWords / lines.size() <= 14);
+}
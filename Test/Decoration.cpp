@@ -0,0 +1,71 @@
+#include <LibUwu.h>
+#include "Catch2.h"
+#include "Timing.h"
+
+namespace {
+    // Text with plenty of symbols to decorate
+    std::string MakeText(const std::size_t length) {
+        const std::string sentence = "Wow. Such symbols, much punctuation! Is it cute? ";
+
+        std::string text;
+        while (text.length() < length)
+            text += sentence;
+
+        return text;
+    }
+
+    std::size_t CountOccurrences(const std::string& str, const std::string& find) {
+        std::size_t count = 0;
+        for (std::size_t pos = str.find(find); pos != std::string::npos; pos = str.find(find, pos + find.length()))
+            count++;
+
+        return count;
+    }
+
+}
+
+// Tests that the same string always gets decorated the same way, no matter what was uwu'd before
+TEST_CASE(__FILE__"/IsDeterministic", "[]")
+{
+    // Setup
+    const std::string in = MakeText(10000);
+    const std::string expected = MakeUwu(in);
+
+    // Exercise
+    MakeUwu(MakeText(1234));
+    MakeUwu("Something else entirely. Really!");
+    const std::string result = MakeUwu(in);
+
+    // Verify
+    REQUIRE(result == expected);
+}
+
+// Tests that about every fifteenth symbol gets decorated
+TEST_CASE(__FILE__"/DecoratesAboutEveryFifteenthSymbol", "[]")
+{
+    // Setup
+    const std::string in = MakeText(100000);
+    const std::size_t symbols = CountOccurrences(in, ".");
+
+    // Exercise
+    const std::size_t decorated = CountOccurrences(MakeUwu(in), " <3333 ^.^ ");
+
+    // Verify
+    REQUIRE(decorated > symbols / 20);
+    REQUIRE(decorated < symbols / 10);
+}
+
+// Tests that decorating costs linear time: 64 times the text may cost 8 times as much per byte, to stay clear of noise
+TEST_CASE(__FILE__"/CostsLinearTime", "[]")
+{
+    // Setup
+    const std::string small = MakeText(1 << 14);
+    const std::string large = MakeText(1 << 20);
+
+    // Exercise
+    const double growth = CostGrowth(small, large);
+
+    // Verify
+    INFO(growth << " times the cost per byte");
+    REQUIRE(growth < 8);
+}
@@ -0,0 +1,62 @@
+#include <Differential.h>
+#include <Corpus.h>
+#include <Util.h>
+#include "Catch2.h"
+#include <string>
+#include <vector>
+
+namespace {
+    void RequireNoMismatch(const std::string& input) {
+        const auto mismatch = Differential::Check(input);
+        if (mismatch)
+            Differential::Print(*Differential::Check(Differential::Minimise(input)), stderr);
+
+        REQUIRE(!mismatch);
+    }
+}
+
+// Tests that the engine produces exactly what the frozen reference produces, on made-up English
+TEST_CASE(__FILE__"/SameAsReferenceOnEnglish", "[]")
+{
+    CorpusGenerator generator({ .seed = 17, .triggerDensity = 0.7, .punctuationDensity = 0.3, .emoticonDensity = 0.1, .allCapsDensity = 0.1 });
+    for (std::size_t i = 0; i < 300; i++)
+        RequireNoMismatch(std::string(1, (char)i) + generator.Line());
+}
+
+// Tests that the engine produces exactly what the frozen reference produces, on random bytes
+TEST_CASE(__FILE__"/SameAsReferenceOnRandomBytes", "[]")
+{
+    std::uint64_t counter = 0;
+    for (std::size_t i = 0; i < 300; i++)
+    {
+        std::string input;
+        const std::size_t length = Util::Random(23, counter++) % 48;
+        for (std::size_t j = 0; j < length; j++)
+            input += (char)Util::Random(23, counter++);
+
+        RequireNoMismatch(input);
+    }
+}
+
+// Tests that the engine produces exactly what the frozen reference produces, on the worst cases there are
+TEST_CASE(__FILE__"/SameAsReferenceOnAdversarialInputs", "[]")
+{
+    for (const CorpusGenerator::AdversarialInput& input : CorpusGenerator::Adversarial(300))
+    {
+        INFO(input.name);
+        RequireNoMismatch(std::string(1, '\x2A') + input.text);
+    }
+}
+
+// Tests that the engine produces exactly what the frozen reference produces, on every two triggers right next to each other.
+// Made-up English puts spaces between them, so it would never have one rule's finding feed right into another's
+TEST_CASE(__FILE__"/SameAsReferenceOnAdjacentTriggers", "[]")
+{
+    const std::vector<std::string> triggers = {
+        "c++", "C++", ":)", ":-)", ":D", "^^", "th", "TH", "have", "hello", "n", "Ne", "r", "Ra", "ll", "er", "y", "Yo", "hi", ".", "!", ",", "?", " "
+    };
+
+    for (const std::string& first : triggers)
+        for (const std::string& second : triggers)
+            RequireNoMismatch('\x01' + first + second + "a");
+}
@@ -0,0 +1,150 @@
+#include <FileTransform.h>
+#include <LibUwu.h>
+#include "Catch2.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    std::string TempPath(const std::string& name) {
+        return (std::filesystem::temp_directory_path() / ("uwwwu-test-" + name)).string();
+    }
+
+    void WriteFile(const std::string& path, const std::string& content) {
+        std::ofstream(path, std::ios::binary) << content;
+    }
+
+    std::string ReadFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        std::stringstream ss;
+        ss << in.rdbuf();
+
+        return ss.str();
+    }
+
+    // What the plain, single-threaded stdin-mode would write
+    std::string Sequential(const std::string& input) {
+        std::istringstream in(input);
+        std::string out;
+        std::string line;
+        while (std::getline(in, line))
+            out += MakeUwu(line) + "\n";
+
+        return out;
+    }
+
+    // Runs `input` through a file transform, and returns what ended up in the output file
+    std::string Transformed(const std::string& input, const std::size_t threads, const std::size_t chunkBytes, const std::size_t windowBytes = 64 << 20) {
+        const std::string inPath = TempPath("in.txt");
+        const std::string outPath = TempPath("out.txt");
+        WriteFile(inPath, input);
+
+        WorkStealingPool pool(threads);
+        FileTransform([](std::string_view line, std::string& out) { MakeUwu(line, out); }, pool, chunkBytes, windowBytes).Run(inPath, outPath);
+
+        const std::string result = ReadFile(outPath);
+        std::filesystem::remove(inPath);
+        std::filesystem::remove(outPath);
+
+        return result;
+    }
+}
+
+// Tests that the output file holds exactly what uwu'ing line by line writes, no matter how the file is chunked
+TEST_CASE(__FILE__"/SameAsSequential", "[]")
+{
+    // Setup
+    std::string input;
+    for (std::size_t i = 0; i < 1000; i++)
+        input += "Line " + std::to_string(i) + ": " + std::string(i % 13, 'r') + " thank you, larry!" + (i % 7 == 0 ? "\n\n" : " :)\n");
+    const std::string expected = Sequential(input);
+
+    SECTION("One thread") { REQUIRE(Transformed(input, 1, 1 << 20) == expected); }
+    SECTION("Many threads") { REQUIRE(Transformed(input, 8, 100) == expected); }
+    SECTION("Line-sized chunks") { REQUIRE(Transformed(input, 4, 1) == expected); }
+}
+
+// Tests that output written window by window, each one appended to the output file, adds up to the same
+TEST_CASE(__FILE__"/ManyWindows", "[]")
+{
+    // Setup
+    std::string input;
+    for (std::size_t i = 0; i < 3000; i++)
+        input += "Window line " + std::to_string(i) + ", with the rules: " + std::string(i % 5, 'l') + "th n :)\n";
+    const std::string expected = Sequential(input);
+
+    // Windows that don't line up with pages, and windows of single chunks
+    SECTION("Odd windows") { REQUIRE(Transformed(input, 4, 100, 1000) == expected); }
+    SECTION("Chunk-sized windows") { REQUIRE(Transformed(input, 2, 4096, 1) == expected); }
+    SECTION("Line-sized windows") { REQUIRE(Transformed(input, 3, 1, 1) == expected); }
+}
+
+// Tests that running into an existing, longer output file leaves nothing of it behind
+TEST_CASE(__FILE__"/OverwritesLongerFile", "[]")
+{
+    // Setup
+    const std::string inPath = TempPath("in-overwrite.txt");
+    const std::string outPath = TempPath("out-overwrite.txt");
+    WriteFile(inPath, "hi\n");
+    WriteFile(outPath, std::string(10000, 'x'));
+
+    // Exercise
+    WorkStealingPool pool(2);
+    FileTransform([](std::string_view line, std::string& out) { out += line; }, pool, 1, 1).Run(inPath, outPath);
+
+    // Verify
+    REQUIRE(ReadFile(outPath) == "hi\n");
+    std::filesystem::remove(inPath);
+    std::filesystem::remove(outPath);
+}
+
+// Tests that a last line without a trailing newline gets one, just like in the stdin-mode
+TEST_CASE(__FILE__"/NoTrailingNewline", "[]")
+{
+    // Setup
+    const std::string input = "hello\n\nthere";
+
+    // Exercise
+    const std::string result = Transformed(input, 2, 3);
+
+    // Verify
+    REQUIRE(result == Sequential(input));
+}
+
+// Tests that an empty file yields an empty file
+TEST_CASE(__FILE__"/EmptyFile", "[]")
+{
+    REQUIRE(Transformed("", 2, 16).empty());
+}
+
+// Tests that a missing input file gets reported
+TEST_CASE(__FILE__"/MissingInput", "[]")
+{
+    FileTransform transform([](std::string_view line, std::string& out) { out += line; });
+    REQUIRE_THROWS_AS(transform.Run(TempPath("does-not-exist.txt"), TempPath("out.txt")), std::runtime_error);
+}
+
+// Tests that writing into the input file gets refused, instead of emptying it
+TEST_CASE(__FILE__"/SameFile", "[]")
+{
+    // Setup
+    const std::string path = TempPath("same.txt");
+    WriteFile(path, "hello\nthere\n");
+    FileTransform transform([](std::string_view line, std::string& out) { out += line; });
+
+    // Exercise, Verify
+    REQUIRE_THROWS_AS(transform.Run(path, path), std::runtime_error);
+    REQUIRE_THROWS_AS(transform.Run(path, (std::filesystem::path(path).parent_path() / "." / "uwwwu-test-same.txt").string()), std::runtime_error);
+    REQUIRE(ReadFile(path) == "hello\nthere\n");
+
+    std::filesystem::remove(path);
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// Tests that inputs without a size, like devices, get refused, instead of read as empty
+TEST_CASE(__FILE__"/NotARegularFile", "[]")
+{
+    FileTransform transform([](std::string_view line, std::string& out) { out += line; });
+    REQUIRE_THROWS_AS(transform.Run("/dev/null", TempPath("out.txt")), std::runtime_error);
+}
+#endif
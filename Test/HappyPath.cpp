@@ -15,3 +15,13 @@ TEST_CASE(__FILE__"/DoesntCrash", "[]")
     SECTION("8") { MakeUwu("gardener"); }
     SECTION("9") { MakeUwu("german"); }
 }
+
+// Tests that "c++" takes the sign of an emoticon following it as it comes out, just like when "c++" got replaced after the emoticons
+TEST_CASE(__FILE__"/CppFollowedByEmoticon", "[]")
+{
+    SECTION("Replaced emoticon") { REQUIRE(MakeUwu("c++:)") == "c++ (RUST IS HELLA CUTEWR BTW ^^)UwU :3"); }
+    SECTION("Other replaced emoticon") { REQUIRE(MakeUwu("C++:-)") == "C++ (RUST IS HELLA CUTEWR BTW ^^)UwwwU :3"); }
+    SECTION("Emoticon without letters") { REQUIRE(MakeUwu("c++^^") == "c++ (rust is hella cutewr btw ^^)^.^ UwU"); }
+    SECTION("Not directly following") { REQUIRE(MakeUwu("c++ :)") == "c++ (rust is hella cutewr btw ^^) UwU :3"); }
+    SECTION("Another c++") { REQUIRE(MakeUwu("c++c++:)") == "c++ (rust is hella cutewr btw ^^)c++ (RUST IS HELLA CUTEWR BTW ^^)UwU :3"); }
+}
@@ -0,0 +1,175 @@
+#include <Kernels.h>
+#include <Util.h>
+#include <CharTools.h>
+#include "Catch2.h"
+#include <string>
+#include <vector>
+
+namespace {
+    //! What FindCandidate has to come out as, one char at a time
+    std::size_t NaiveFindCandidate(const std::string& text, std::size_t pos, std::size_t end, const std::string& lowerFind) {
+        for (std::size_t i = pos; i < end; i++)
+        {
+            if (CharTools::MakeLower(text[i]) != lowerFind[0])
+                continue;
+
+            if ((lowerFind.length() == 1) || ((i + 1 < text.length()) && (CharTools::MakeLower(text[i + 1]) == lowerFind[1])))
+                return i;
+        }
+
+        return end;
+    }
+
+    //! Every level this CPU can run the kernels on
+    std::vector<Kernels::Level> SupportedLevels() {
+        std::vector<Kernels::Level> levels;
+        for (const Kernels::Level level : { Kernels::Level::scalar, Kernels::Level::sse42, Kernels::Level::avx2, Kernels::Level::avx512bw })
+            if (level <= Kernels::BestLevel())
+                levels.push_back(level);
+
+        return levels;
+    }
+}
+
+// Tests that the candidate scans of all levels find the same as a plain one, wherever candidates are, relative to the vectors
+TEST_CASE(__FILE__"/FindCandidateSameAsNaive", "[]")
+{
+    // Setup
+    std::string text;
+    for (std::size_t i = 0; i < 300; i++)
+        text += "abcdeTHfghij:)Nn^^RrlL y"[Util::Random(1, i) % 24];
+    const Kernels::Level before = Kernels::ActiveLevel();
+
+    for (const Kernels::Level level : SupportedLevels())
+    for (const std::string find : { "th", "n", "r", ":)", "^^", "ll", "y", "z", "zz" })
+        for (std::size_t pos = 0; pos < 70; pos++)
+            for (const std::size_t end : { text.length(), text.length() - 1, std::size_t{ 100 }, std::size_t{ 64 }, pos })
+            {
+                if (end < pos)
+                    continue;
+
+                // Exercise
+                REQUIRE(Kernels::UseLevel(level));
+                const std::size_t found = Kernels::FindCandidate(text, pos, end, find);
+
+                // Verify
+                REQUIRE(found == NaiveFindCandidate(text, pos, end, find));
+                REQUIRE(found == Kernels::FindCandidateSwar(text, pos, end, find));
+            }
+
+    Kernels::UseLevel(before);
+}
+
+// Tests that a two-char finding doesn't get matched half outside of the text, on any level
+TEST_CASE(__FILE__"/SecondCharNotPastText", "[]")
+{
+    // Setup
+    const Kernels::Level before = Kernels::ActiveLevel();
+
+    for (const Kernels::Level level : SupportedLevels())
+        for (const std::size_t length : { std::size_t{ 1 }, std::size_t{ 40 }, std::size_t{ 64 }, std::size_t{ 100 } })
+        {
+            const std::string text = std::string(length - 1, 'a') + "t";
+
+            // Exercise
+            REQUIRE(Kernels::UseLevel(level));
+            const std::size_t found = Kernels::FindCandidate(text, 0, text.length(), "th");
+
+            // Verify
+            REQUIRE(found == text.length());
+        }
+
+    Kernels::UseLevel(before);
+}
+
+// Tests that the classifications of all levels agree with CharTools on every char, at every position within the bitmaps
+TEST_CASE(__FILE__"/ClassifySameAsCharTools", "[]")
+{
+    // Setup
+    std::string text;
+    for (std::size_t i = 0; i < 1000; i++)
+        text += static_cast<char>(Util::Random(2, i) % 256);
+    text += "Hello World, AEIOU aeiou yY zZ@[`{";
+    const Kernels::Level before = Kernels::ActiveLevel();
+
+    for (const Kernels::Level level : SupportedLevels())
+    for (const std::size_t length : { std::size_t{ 0 }, std::size_t{ 1 }, std::size_t{ 63 }, std::size_t{ 64 }, std::size_t{ 65 }, std::size_t{ 200 }, text.length() })
+    {
+        const std::string_view part = std::string_view(text).substr(text.length() - length);
+        std::vector<std::uint64_t> letters((length + 63) / 64, ~0ull);
+        std::vector<std::uint64_t> vowels((length + 63) / 64, ~0ull);
+        std::vector<std::uint64_t> uppers((length + 63) / 64, ~0ull);
+
+        // Exercise
+        REQUIRE(Kernels::UseLevel(level));
+        Kernels::Classify(part, letters.data(), vowels.data(), uppers.data());
+
+        // Verify
+        for (std::size_t i = 0; i < letters.size() * 64; i++)
+        {
+            const bool exists = i < length;
+            REQUIRE(((letters[i / 64] >> (i % 64)) & 1) == (exists && CharTools::IsLetter(part[i])));
+            REQUIRE(((vowels[i / 64] >> (i % 64)) & 1) == (exists && CharTools::IsVowel(part[i])));
+            REQUIRE(((uppers[i / 64] >> (i % 64)) & 1) == (exists && CharTools::IsUpper(part[i])));
+        }
+    }
+
+    Kernels::UseLevel(before);
+}
+
+// Tests that the SWAR comparison agrees with CharTools on every char, at every position within the words
+TEST_CASE(__FILE__"/EqualsIgnoringCaseSameAsCharTools", "[]")
+{
+    // Setup
+    std::string text;
+    for (std::size_t i = 0; i < 256; i++)
+        text += static_cast<char>(i);
+    std::string lowerText;
+    for (const char c : text)
+        lowerText += CharTools::MakeLower(c);
+
+    for (std::size_t pos = 0; pos < text.length(); pos++)
+        for (const std::size_t length : { std::size_t{ 0 }, std::size_t{ 1 }, std::size_t{ 7 }, std::size_t{ 8 }, std::size_t{ 9 }, std::size_t{ 20 } })
+        {
+            const std::string_view part = std::string_view(text).substr(pos, length);
+            const std::string_view lowerPart = std::string_view(lowerText).substr(pos, length);
+
+            // Exercise, Verify
+            REQUIRE(Kernels::EqualsIgnoringCase(part, lowerPart));
+            REQUIRE(!Kernels::EqualsIgnoringCase(part, std::string(lowerPart) + "a"));
+
+            // Any other char, anywhere, makes a difference
+            for (std::size_t i = 0; i < part.length(); i++)
+            {
+                std::string other(lowerPart);
+                other[i] = static_cast<char>(other[i] ^ 0x20);
+                REQUIRE(!Kernels::EqualsIgnoringCase(part, other));
+            }
+        }
+}
+
+// Tests that levels past what the CPU can do get refused, and that the level names read back
+TEST_CASE(__FILE__"/UseLevel", "[]")
+{
+    // Setup
+    const Kernels::Level before = Kernels::ActiveLevel();
+
+    for (const Kernels::Level level : { Kernels::Level::scalar, Kernels::Level::sse42, Kernels::Level::avx2, Kernels::Level::avx512bw })
+    {
+        // Exercise
+        const bool used = Kernels::UseLevel(level);
+
+        // Verify
+        REQUIRE(used == (level <= Kernels::BestLevel()));
+        REQUIRE(Kernels::ActiveLevel() == (used ? level : before));
+
+        Kernels::Level parsed = Kernels::Level::scalar;
+        REQUIRE(Kernels::ParseLevel(Kernels::LevelName(level), parsed));
+        REQUIRE(parsed == level);
+
+        Kernels::UseLevel(before);
+    }
+
+    Kernels::Level parsed;
+    REQUIRE_FALSE(Kernels::ParseLevel("avx", parsed));
+}
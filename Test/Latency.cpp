@@ -0,0 +1,99 @@
+#include <LibUwu.h>
+#include "Catch2.h"
+#include <chrono>
+#include <string>
+
+// Tests that percentiles come out within the histogram's precision
+TEST_CASE(__FILE__"/PercentilesWithinPrecision", "[]")
+{
+    // Setup
+    LatencyHistogram histogram;
+
+    // Exercise
+    for (std::uint64_t microseconds = 1; microseconds <= 1000; microseconds++)
+        histogram.Record(microseconds * 1000);
+
+    // Verify
+    REQUIRE(histogram.Count() == 1000);
+    REQUIRE(histogram.Max() == 1000000);
+    REQUIRE(histogram.Percentile(0.5) == Approx(500000).epsilon(0.07));
+    REQUIRE(histogram.Percentile(0.9) == Approx(900000).epsilon(0.07));
+    REQUIRE(histogram.Percentile(0.99) == Approx(990000).epsilon(0.07));
+    REQUIRE(histogram.Percentile(1) == 1000000);
+}
+
+// Tests that small latencies are kept exactly, and an empty histogram says 0
+TEST_CASE(__FILE__"/SmallAndEmpty", "[]")
+{
+    // Setup
+    LatencyHistogram histogram;
+    REQUIRE(histogram.Percentile(0.5) == 0);
+
+    // Exercise
+    histogram.Record(3);
+    histogram.Record(7);
+
+    // Verify
+    REQUIRE(histogram.Percentile(0.5) == 3);
+    REQUIRE(histogram.Percentile(1) == 7);
+}
+
+// Tests that latencies get bucketed by input size
+TEST_CASE(__FILE__"/BucketedBySize", "[]")
+{
+    // Setup
+    LatencyRecorder recorder;
+
+    // Exercise
+    recorder.Record(std::string(10, 'a'), std::chrono::microseconds(1));
+    recorder.Record(std::string(64, 'a'), std::chrono::microseconds(2));
+    recorder.Record(std::string(300, 'a'), std::chrono::microseconds(3));
+    recorder.Record(std::string(2000000, 'a'), std::chrono::microseconds(4));
+
+    // Verify
+    REQUIRE(recorder.Overall().Count() == 4);
+    REQUIRE(recorder.BySize(0).Count() == 1);
+    REQUIRE(recorder.BySize(1).Count() == 1);
+    REQUIRE(recorder.BySize(2).Count() == 1);
+    REQUIRE(recorder.BySize(LatencyRecorder::sizeBucketCount - 1).Count() == 1);
+    REQUIRE(recorder.BySize(LatencyRecorder::sizeBucketCount - 1).Max() == 4000);
+}
+
+// Tests that only the slowest inputs are kept, truncated, slowest first
+TEST_CASE(__FILE__"/KeepsSlowest", "[]")
+{
+    // Setup
+    LatencyRecorder recorder(3, 4);
+
+    // Exercise
+    for (int i = 0; i < 10; i++)
+        recorder.Record("input " + std::to_string(i), std::chrono::microseconds((i * 7) % 10));
+
+    // Verify
+    const std::vector<LatencyRecorder::SlowInput> slowest = recorder.Slowest();
+    REQUIRE(slowest.size() == 3);
+    REQUIRE(slowest[0].nanoseconds == 9000);
+    REQUIRE(slowest[1].nanoseconds == 8000);
+    REQUIRE(slowest[2].nanoseconds == 7000);
+    REQUIRE(slowest[0].text == "inpu");
+    REQUIRE(slowest[0].length == 7);
+}
+
+// Tests that MakeUwu records into the installed recorder, and stops once it's uninstalled
+TEST_CASE(__FILE__"/MakeUwuRecords", "[]")
+{
+    // Setup
+    LatencyRecorder recorder;
+
+    // Exercise
+    LatencyRecorder::Install(&recorder);
+    MakeUwu("Hello there");
+    MakeUwu(std::string(1000, 'r'));
+    LatencyRecorder::Install(nullptr);
+    MakeUwu("Not recorded");
+
+    // Verify
+    REQUIRE(recorder.Overall().Count() == 2);
+    REQUIRE(recorder.BySize(0).Count() == 1);
+    REQUIRE(recorder.Slowest().size() == 2);
+}
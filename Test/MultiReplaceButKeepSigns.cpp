@@ -0,0 +1,225 @@
+#include <Util.h>
+#include "Catch2.h"
+
+// Test that putting in an empty string returns an empty string
+TEST_CASE(__FILE__"/EmptyInputString", "[]")
+{
+    // Setup
+    const std::string in = "";
+    const std::string expected = "";
+
+    // Exercise
+    const std::string result = Util::MultiReplaceButKeepSigns(in, {
+        { "findme", "putme" },
+        { "orme", "putmetoo" }
+    });
+
+    // Verify
+    REQUIRE(result == expected);
+}
+
+// Test that an empty table changes nothing
+TEST_CASE(__FILE__"/EmptyTable", "[]")
+{
+    // Setup
+    const std::string in = "Hello $user, you must be $user, so i am calling you $user.";
+    const std::string expected = in;
+
+    // Exercise
+    const std::string result = Util::MultiReplaceButKeepSigns(in, std::vector<Util::Replacement>());
+
+    // Verify
+    REQUIRE(result == expected);
+}
+
+// Tests that a table with just one entry does the same as ConditionalReplaceButKeepSigns
+TEST_CASE(__FILE__"/SingleEntrySameAsConditionalReplace", "[]")
+{
+    // Setup
+    const std::string in = "Hi Alice. HI Alice. hi Alice. hI Alice. HIalice. hiALICE.";
+    const std::string expected = Util::ConditionalReplaceButKeepSigns(in, "hi", "hello");
+
+    // Exercise
+    const std::string result = Util::MultiReplaceButKeepSigns(in, {
+        { "hi", "hello" }
+    });
+
+    // Verify
+    REQUIRE(result == expected);
+}
+
+// Tests that multiple findings get replaced in the same scan, keeping their signs
+TEST_CASE(__FILE__"/MultipleFindings", "[]")
+{
+    // Setup
+    const std::string in = "Hello Alice, lowercase alice, WTF ALICE?! Say hello to BOB.";
+    const std::string expected = "Hi Carol, lowercase carol, WTF CAROL?! Say hi to DAVE.";
+
+    // Exercise
+    const std::string result = Util::MultiReplaceButKeepSigns(in, {
+        { "alice", "carol" },
+        { "bob", "dave" },
+        { "hello", "hi" }
+    });
+
+    // Verify
+    REQUIRE(result == expected);
+}
+
+// Tests that replacements never see what other replacements put in
+TEST_CASE(__FILE__"/NoChaining", "[]")
+{
+    // Setup
+    const std::string in = "cat dog";
+    const std::string expected = "dog cat";
+
+    // Exercise
+    const std::string result = Util::MultiReplaceButKeepSigns(in, {
+        { "cat", "dog" },
+        { "dog", "cat" }
+    });
+
+    // Verify
+    REQUIRE(result == expected);
+}
+
+// Tests that a sub longer than its finding takes the sign of the following char as it comes out, after that one got replaced
+TEST_CASE(__FILE__"/LongerSubTakesSignOfReplacedFollowingChar", "[]")
+{
+    // Setup
+    const Util::ReplacementTable table = {
+        { "cat", "kitty" },
+        { "dog", "puppy" },
+        { ":)", "UwU", nullptr, false }
+    };
+
+    SECTION("Uppercase")
+    {
+        // Exercise
+        const std::string result = Util::MultiReplaceButKeepSigns("catDOG", table);
+
+        // Verify
+        REQUIRE(result == "kitTYPUPPY");
+    }
+
+    SECTION("Lowercase")
+    {
+        // Exercise
+        const std::string result = Util::MultiReplaceButKeepSigns("CATdog", table);
+
+        // Verify
+        REQUIRE(result == "KITtypuppy");
+    }
+
+    SECTION("Case-sensitive")
+    {
+        // Exercise
+        const std::string result = Util::MultiReplaceButKeepSigns("cat:)", table);
+
+        // Verify
+        REQUIRE(result == "kitTYUwU");
+    }
+}
+
+// Tests that, if multiple replacements are found at the same index, the first one in the table wins
+TEST_CASE(__FILE__"/EarlierEntriesTakePrecedence", "[]")
+{
+    SECTION("Shorter first")
+    {
+        // Exercise
+        const std::string result = Util::MultiReplaceButKeepSigns("the theme", {
+            { "the", "a" },
+            { "theme", "topic" }
+        });
+
+        // Verify
+        REQUIRE(result == "a ame");
+    }
+
+    SECTION("Longer first")
+    {
+        // Exercise
+        const std::string result = Util::MultiReplaceButKeepSigns("the theme", {
+            { "theme", "topic" },
+            { "the", "a" }
+        });
+
+        // Verify
+        REQUIRE(result == "a topic");
+    }
+}
+
+// Tests that a rejected replacement makes way for the next one found at the same index
+TEST_CASE(__FILE__"/RejectedEntryFallsThrough", "[]")
+{
+    // Setup
+    const std::string in = "the theme";
+    const std::string expected = "the topic";
+
+    // Exercise
+    const std::string result = Util::MultiReplaceButKeepSigns(in, {
+        { "the", "a", [](const std::string&, const std::string&, const std::size_t) {
+            return false;
+        }},
+        { "theme", "topic" }
+    });
+
+    // Verify
+    REQUIRE(result == expected);
+}
+
+// Tests that, if all replacements are rejected, the first finding is skipped as a whole, just like ConditionalReplaceButKeepSigns does
+TEST_CASE(__FILE__"/RejectingAllSkipsFinding", "[]")
+{
+    // Setup
+    const std::string in = "aaaa";
+    const std::string expected = "aaaa";
+
+    std::vector<std::size_t> indices;
+
+    // Exercise
+    const std::string result = Util::MultiReplaceButKeepSigns(in, {
+        { "aa", "b", [&indices](const std::string&, const std::string&, const std::size_t index) {
+            indices.push_back(index);
+            return false;
+        }}
+    });
+
+    // Verify
+    REQUIRE(result == expected);
+    REQUIRE(indices == std::vector<std::size_t>{ 0, 2 });
+}
+
+// Tests that the callback gets the same arguments ConditionalReplaceButKeepSigns would pass
+TEST_CASE(__FILE__"/Callback_Arguments_Match", "[]")
+{
+    // Setup
+    const std::string in = "Hello, BANAna.";
+
+    // Exercise
+    Util::MultiReplaceButKeepSigns(in, {
+        { "banana", "hello", [in](const std::string& original, const std::string& finding, const std::size_t index) -> bool {
+            REQUIRE(original == in);
+            REQUIRE(finding == "BANAna");
+            REQUIRE(index == 7);
+            return true;
+        }}
+    });
+}
+
+// Tests that entries not keeping signs match case-sensitively and are put in as is
+TEST_CASE(__FILE__"/CaseSensitiveEntries", "[]")
+{
+    // Setup
+    const std::string in = ":D :d :)x";
+    const std::string expected = ":3 :d UwU :3x";
+
+    // Exercise
+    const std::string result = Util::MultiReplaceButKeepSigns(in, {
+        { ":)", "UwU :3", nullptr, false },
+        { ":D", ":3", nullptr, false }
+    });
+
+    // Verify
+    REQUIRE(result == expected);
+}
@@ -0,0 +1,68 @@
+#include <Pipeline.h>
+#include <LibUwu.h>
+#include "Catch2.h"
+#include <sstream>
+
+namespace {
+    // Lines of all kinds of lengths, including empty ones
+    std::string MakeInput(const std::size_t lines) {
+        std::stringstream ss;
+        for (std::size_t i = 0; i < lines; i++)
+            ss << "Line " << i << ": " << std::string(i % 13, 'r') << " thank you, larry!" << (i % 7 == 0 ? "" : " :)") << "\n";
+
+        return ss.str();
+    }
+
+    // What the plain, single-threaded stdin-mode would write
+    std::string Sequential(const std::string& input) {
+        std::istringstream in(input);
+        std::ostringstream out;
+        std::string line;
+        while (std::getline(in, line))
+            out << MakeUwu(line) << "\n";
+
+        return out.str();
+    }
+
+    std::string Parallel(const std::string& input, const std::size_t workers, const std::size_t batchLines, const std::size_t batchesInFlight) {
+        std::istringstream in(input);
+        std::ostringstream out;
+        Pipeline([](const std::string& line) { return MakeUwu(line); }, workers, batchLines, 1 << 20, batchesInFlight).Run(in, out);
+
+        return out.str();
+    }
+}
+
+// Tests that an empty input yields an empty output
+TEST_CASE(__FILE__"/EmptyInput", "[]")
+{
+    REQUIRE(Parallel("", 4, 16, 0).empty());
+}
+
+// Tests that the output is in input order, no matter how the work is split up
+TEST_CASE(__FILE__"/SameAsSequential", "[]")
+{
+    // Setup
+    const std::string input = MakeInput(1000);
+    const std::string expected = Sequential(input);
+
+    SECTION("One worker") { REQUIRE(Parallel(input, 1, 16, 0) == expected); }
+    SECTION("Many workers") { REQUIRE(Parallel(input, 8, 16, 0) == expected); }
+    SECTION("Single-line batches") { REQUIRE(Parallel(input, 4, 1, 0) == expected); }
+    SECTION("One batch in flight") { REQUIRE(Parallel(input, 4, 7, 1) == expected); }
+    SECTION("Huge batches") { REQUIRE(Parallel(input, 4, 100000, 0) == expected); }
+}
+
+// Tests that a last line without a trailing newline gets one, just like in the sequential mode
+TEST_CASE(__FILE__"/NoTrailingNewline", "[]")
+{
+    // Setup
+    const std::string input = "hello\n\nthere";
+
+    // Exercise
+    const std::string result = Parallel(input, 2, 1, 0);
+
+    // Verify
+    REQUIRE(result == Sequential(input));
+    REQUIRE(result.back() == '\n');
+}
@@ -0,0 +1,56 @@
+#include <LibUwu.h>
+#include <Corpus.h>
+#include "Catch2.h"
+#include <set>
+#include <string>
+
+// Tests that every rule can be told apart by its name
+TEST_CASE(__FILE__"/NamesAreUnique", "[]")
+{
+    std::set<std::string> names;
+    for (const UwuRule& rule : UwuRules())
+        REQUIRE(names.insert(rule.name).second);
+}
+
+// Tests that running the rules one by one, each on its own, comes out the same as MakeUwu
+TEST_CASE(__FILE__"/OneByOneSameAsMakeUwu", "[]")
+{
+    // Setup
+    const std::string in = "Thank you, Larry! The river was really good at one o'clock. Yes, you have to try it :) "
+                           "Hello dear gardener, well, nine cats are running up the alley ^^ Love c++? :D ";
+    constexpr std::uint64_t seed = 7;
+    const std::uint64_t key = Util::Random(seed, Util::Hash(in));
+
+    // Exercise
+    std::string result = in;
+    for (const UwuRule& rule : UwuRules())
+        result = Cascade().Then(rule.stage).Run(result, key);
+
+    // Verify
+    REQUIRE(result == MakeUwu(in, seed));
+}
+
+// Tests that MakeUwu's rules come out the same, no matter how small the cascade's blocks are
+TEST_CASE(__FILE__"/AnyBlockSizeSameAsOneByOne", "[]")
+{
+    // Setup
+    const std::string in = CorpusGenerator({ .seed = 9, .triggerDensity = 0.6, .punctuationDensity = 0.3, .emoticonDensity = 0.1 }).Text(20000);
+    const std::uint64_t key = Util::Random(0, Util::Hash(in));
+
+    std::string expected = in;
+    for (const UwuRule& rule : UwuRules())
+        expected = Cascade().Then(rule.stage).Run(expected, key);
+
+    for (const std::size_t blockSize : { 1, 3, 64, 4096, 100000 })
+    {
+        Cascade cascade(blockSize);
+        for (const UwuRule& rule : UwuRules())
+            cascade.Then(rule.stage);
+
+        // Exercise
+        const std::string result = cascade.Run(in, key);
+
+        // Verify
+        REQUIRE(result == expected);
+    }
+}
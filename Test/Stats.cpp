@@ -0,0 +1,98 @@
+#include <LibUwu.h>
+#include "Catch2.h"
+#include <string>
+#include <thread>
+
+namespace {
+    //! Index of the rule MakeUwu runs as `name`
+    std::size_t RuleIndex(const std::string& name) {
+        for (std::size_t r = 0; r < UwuRules().size(); r++)
+            if (UwuRules()[r].name == name)
+                return r;
+
+        return Stats::maxRules;
+    }
+}
+
+// Tests that an instrumented stage gets the bytes it consumed and produced counted, and whatever it counts itself
+TEST_CASE(__FILE__"/InstrumentCountsBytes", "[]")
+{
+    // Setup
+    constexpr std::size_t rule = Stats::maxRules - 1;
+    Stats::Reset();
+
+    const Cascade cascade = Cascade(4).Then(Stats::Instrument(rule, [](const std::string& in, std::size_t pos, bool, std::string& out, const Cascade::RunInfo&) {
+        for (; pos < in.length(); pos++)
+        {
+            Stats::Count(Stats::candidates);
+            out += in[pos];
+            out += in[pos];
+        }
+
+        return pos;
+    }));
+
+    // Exercise
+    const std::string result = cascade.Run("hello world");
+
+    // Verify
+    const Stats::Counters counters = Stats::Aggregate()[rule];
+    REQUIRE(result == "hheelllloo  wwoorrlldd");
+    REQUIRE(counters[Stats::candidates] == 11);
+    REQUIRE(counters[Stats::bytesIn] == 11);
+    REQUIRE(counters[Stats::bytesOut] == 22);
+}
+
+// Tests that counts of threads that have exited still make it into the aggregate
+TEST_CASE(__FILE__"/ExitedThreadsCount", "[]")
+{
+    // Setup
+    constexpr std::size_t rule = Stats::maxRules - 1;
+    Stats::Reset();
+
+    const Cascade cascade = Cascade().Then(Stats::Instrument(rule, [](const std::string& in, std::size_t pos, bool, std::string& out, const Cascade::RunInfo&) {
+        Stats::Count(Stats::accepts);
+        out.append(in, pos);
+        return in.length();
+    }));
+
+    // Exercise
+    for (int i = 0; i < 4; i++)
+        std::thread([&cascade]() { cascade.Run("uwu"); }).join();
+
+    // Verify
+    REQUIRE(Stats::Aggregate()[rule][Stats::accepts] == 4);
+    REQUIRE(Stats::Aggregate()[rule][Stats::bytesIn] == 12);
+}
+
+// Tests that MakeUwu counts per rule, if built with stats, and doesn't count anything, if not
+TEST_CASE(__FILE__"/MakeUwuCountsPerRule", "[]")
+{
+    // Setup
+    Stats::Reset();
+
+    // Exercise
+    MakeUwu("The thing is: Those that think, thrive. The end");
+
+    // Verify
+    const Stats::Counters th = Stats::Aggregate()[RuleIndex("th")];
+    const Stats::Counters emacs = Stats::Aggregate()[RuleIndex("emacs")];
+    if constexpr (Stats::enabled)
+    {
+        // Every "th" is a candidate, gets validated, and replaced
+        REQUIRE(th[Stats::candidates] == 7);
+        REQUIRE(th[Stats::validatorCalls] == 7);
+        REQUIRE(th[Stats::accepts] == 7);
+        REQUIRE(th[Stats::bytesIn] == 47);
+        REQUIRE(th[Stats::bytesOut] == 47);
+
+        // This one never fires
+        REQUIRE(emacs[Stats::accepts] == 0);
+        REQUIRE(emacs[Stats::bytesIn] > 0);
+    }
+    else
+    {
+        REQUIRE(th == Stats::Counters{});
+        REQUIRE(emacs == Stats::Counters{});
+    }
+}
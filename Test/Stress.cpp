@@ -0,0 +1,208 @@
+#include <LibUwu.h>
+#include <Pipeline.h>
+#include <WorkStealingPool.h>
+#include "Catch2.h"
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Lines hitting every rule, of all kinds of lengths
+    std::vector<std::string> MakeLines() {
+        const std::vector<std::string> words = {
+            "the", "Thank you", "thanks", "good", "super", "well", "emacs", "hello", "dear", "hi", "say", "hey",
+            "one", "nine", "Nintendo", "rally", "Larry", "gardener", "river", "yes", "YOU", "yay", "c++",
+            ":)", ":D", ":-)", "^^", ".", "!", ",", "?", "love", "have", "trap", "up"
+        };
+
+        std::vector<std::string> lines;
+        for (std::size_t i = 0; i < 200; i++)
+        {
+            std::string line;
+            for (std::size_t j = 0; j < (i * 7) % 60; j++)
+                line += words[(i * 31 + j * 17) % words.size()] + " ";
+
+            // Every now and then, a long one that spans multiple blocks
+            if (i % 50 == 0)
+                while (line.length() < 20000)
+                    line += line + " ";
+
+            lines.push_back(line);
+        }
+
+        return lines;
+    }
+
+    std::size_t NumThreads() {
+        return std::max<std::size_t>(8, 2 * std::thread::hardware_concurrency());
+    }
+}
+
+// Tests that uwu'ing from many threads at once yields exactly what uwu'ing on a single thread yields.
+// Build with UWWWU_TSAN=ON to have ThreadSanitizer watch over this.
+TEST_CASE(__FILE__"/ManyThreadsSameAsOneThread", "[]")
+{
+    // Setup
+    const std::vector<std::string> lines = MakeLines();
+    constexpr std::uint64_t seeds[] = { 0, 1, 0xDEADBEEF };
+
+    std::vector<std::vector<std::string>> expected;
+    for (const std::uint64_t seed : seeds)
+    {
+        expected.emplace_back();
+        for (const std::string& line : lines)
+            expected.back().push_back(MakeUwu(line, seed));
+    }
+
+    // Exercise
+    // Every thread goes through all lines and seeds, each starting somewhere else, so they all hit the same rules at different times
+    std::atomic<std::size_t> mismatches{ 0 };
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < NumThreads(); t++)
+    {
+        threads.emplace_back([&, t]() {
+            for (std::size_t round = 0; round < 3; round++)
+                for (std::size_t i = 0; i < lines.size(); i++)
+                {
+                    const std::size_t line = (i + t * 13) % lines.size();
+                    const std::size_t seed = (i + t + round) % std::size(seeds);
+
+                    if (MakeUwu(lines[line], seeds[seed]) != expected[seed][line])
+                        mismatches++;
+                }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // Verify
+    REQUIRE(mismatches == 0);
+}
+
+// Tests that the library's building blocks can be used from many threads at once, too
+TEST_CASE(__FILE__"/BuildingBlocksFromManyThreads", "[]")
+{
+    // Setup
+    const std::vector<std::string> lines = MakeLines();
+    const Util::ReplacementTable table = {
+        { "th", "tw" },
+        { "one", "uwu", ValidatorFindingIsCompleteWord },
+        { ":)", "UwU", nullptr, false }
+    };
+    const Cascade cascade = Cascade(64)
+            .Then(Cascade::ReplaceButKeepSigns("r", "w"))
+            .Then(Cascade::MultiReplaceButKeepSigns(table));
+
+    std::vector<std::string> expected;
+    for (const std::string& line : lines)
+        expected.push_back(cascade.Run(Util::ConditionalReplaceButKeepSigns(line, "l", "w")));
+
+    // Exercise
+    std::atomic<std::size_t> mismatches{ 0 };
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < NumThreads(); t++)
+    {
+        threads.emplace_back([&, t]() {
+            for (std::size_t i = 0; i < lines.size(); i++)
+            {
+                const std::size_t line = (i + t * 7) % lines.size();
+                if (cascade.Run(Util::ConditionalReplaceButKeepSigns(lines[line], "l", "w")) != expected[line])
+                    mismatches++;
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // Verify
+    REQUIRE(mismatches == 0);
+}
+
+// Tests that the parallel stdin-pipeline writes exactly what uwu'ing line by line writes
+TEST_CASE(__FILE__"/PipelineSameAsSequential", "[]")
+{
+    // Setup
+    std::string input;
+    std::string expected;
+    for (std::size_t round = 0; round < 5; round++)
+        for (const std::string& line : MakeLines())
+        {
+            input += line + "\n";
+            expected += MakeUwu(line) + "\n";
+        }
+
+    // Exercise
+    std::istringstream in(input);
+    std::ostringstream out;
+    Pipeline([](const std::string& line) { return MakeUwu(line); }, NumThreads(), 3, 1 << 20, 2).Run(in, out);
+
+    // Verify
+    REQUIRE(out.str() == expected);
+}
+
+// Tests that many threads can hand batches to the shared work-stealing pool at once
+TEST_CASE(__FILE__"/BatchesFromManyThreads", "[]")
+{
+    // Setup
+    const std::vector<std::string> lines = MakeLines();
+    const std::vector<std::string_view> views(lines.begin(), lines.end());
+
+    std::vector<std::string> expected;
+    for (const std::string& line : lines)
+        expected.push_back(MakeUwu(line, 7));
+
+    // Exercise
+    std::atomic<std::size_t> mismatches{ 0 };
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < NumThreads(); t++)
+    {
+        threads.emplace_back([&]() {
+            std::vector<std::string> result(lines.size());
+            for (std::size_t round = 0; round < 3; round++)
+            {
+                MakeUwuBatch(views, result, 7);
+                if (result != expected)
+                    mismatches++;
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // Verify
+    REQUIRE(mismatches == 0);
+}
+
+// Tests that a work-stealing pool with more threads than there are cores survives many threads handing it jobs at once
+TEST_CASE(__FILE__"/WorkStealingPoolFromManyThreads", "[]")
+{
+    // Setup
+    const std::vector<std::string> lines = MakeLines();
+    WorkStealingPool pool(NumThreads());
+
+    // Exercise
+    std::atomic<std::size_t> mismatches{ 0 };
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < NumThreads(); t++)
+    {
+        threads.emplace_back([&]() {
+            std::vector<std::string> result(lines.size());
+            pool.ForEach(lines.size(), [&](std::size_t i) { result[i] = MakeUwu(lines[i]); });
+
+            for (std::size_t i = 0; i < lines.size(); i++)
+                if (result[i] != MakeUwu(lines[i]))
+                    mismatches++;
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // Verify
+    REQUIRE(mismatches == 0);
+}
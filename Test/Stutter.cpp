@@ -0,0 +1,87 @@
+#include <LibUwu.h>
+#include "Catch2.h"
+#include <vector>
+
+namespace {
+    // Lots of words the stutter-rule applies to
+    const std::string text = "yes you yay yo-yo. your yogurt, yes! yaaay you yes yo yarn yelling yuck you you yes.";
+
+    std::size_t CountOccurrences(const std::string& str, const std::string& find) {
+        std::size_t count = 0;
+        for (std::size_t pos = str.find(find); pos != std::string::npos; pos = str.find(find, pos + find.length()))
+            count++;
+
+        return count;
+    }
+}
+
+// Tests that the same string and seed always come out the same
+TEST_CASE(__FILE__"/SameSeedSameOutput", "[]")
+{
+    // Setup
+    const std::string expected = MakeUwu(text, 1337);
+
+    // Exercise
+    MakeUwu(text, 42);
+    MakeUwu("yes yes yes yes");
+    const std::string result = MakeUwu(text, 1337);
+
+    // Verify
+    REQUIRE(result == expected);
+}
+
+// Tests that not passing a seed is the same as passing 0
+TEST_CASE(__FILE__"/DefaultSeedIsZero", "[]")
+{
+    REQUIRE(MakeUwu(text) == MakeUwu(text, 0));
+}
+
+// Tests that different seeds stutter differently
+TEST_CASE(__FILE__"/DifferentSeedsDiffer", "[]")
+{
+    // Exercise
+    const std::string a = MakeUwu(text, 1);
+    const std::string b = MakeUwu(text, 2);
+    const std::string c = MakeUwu(text, 3);
+
+    // Verify
+    REQUIRE(((a != b) || (b != c)));
+}
+
+// Tests that processing lines out of order yields the same lines as processing them in order
+TEST_CASE(__FILE__"/OrderDoesntMatter", "[]")
+{
+    // Setup
+    std::vector<std::string> lines;
+    for (std::size_t i = 0; i < 50; i++)
+        lines.push_back(text.substr(i % 10) + " line " + std::to_string(i));
+
+    std::vector<std::string> expected;
+    for (const std::string& line : lines)
+        expected.push_back(MakeUwu(line));
+
+    // Exercise
+    std::vector<std::string> result(lines.size());
+    for (std::size_t i = lines.size(); i > 0; i--)
+        result[i - 1] = MakeUwu(lines[i - 1]);
+
+    // Verify
+    REQUIRE(result == expected);
+}
+
+// Tests that only some of the 'y's stutter
+TEST_CASE(__FILE__"/StuttersSometimes", "[]")
+{
+    // Setup
+    std::string in;
+    for (std::size_t i = 0; i < 1000; i++)
+        in += "you ";
+
+    // Exercise
+    const std::size_t stutters = CountOccurrences(MakeUwu(in), "y-you");
+
+    // Verify
+    // The chance is 40%
+    REQUIRE(stutters > 300);
+    REQUIRE(stutters < 500);
+}
@@ -0,0 +1,36 @@
+#ifndef UWWWU_TEST_TIMING_H
+#define UWWWU_TEST_TIMING_H
+
+#include <LibUwu.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+//! How many times more MakeUwu costs per byte on `large` than on `small`. 1 is perfectly linear.
+//! `small` gets uwu'd over and over, for about as many bytes as `large` has, so both timings are about as long.
+//! Each one is the best of five, which keeps a busy machine from making up a difference. Debug builds are fine, too:
+//! A constant factor slower cancels out. Quadratic cost doesn't, that makes this grow with the difference in length.
+inline double CostGrowth(const std::string& small, const std::string& large) {
+    const auto nanosecondsPerByte = [](const std::string& text, const std::size_t calls) {
+        double best = 0;
+        for (int i = 0; i < 5; i++)
+        {
+            const auto begin = std::chrono::steady_clock::now();
+            for (std::size_t c = 0; c < calls; c++)
+                MakeUwu(text);
+            const auto end = std::chrono::steady_clock::now();
+
+            const double perByte = std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(text.length() * calls);
+            best = (i == 0) ? perByte : std::min(best, perByte);
+        }
+
+        return best;
+    };
+
+    const std::size_t calls = std::max<std::size_t>(large.length() / std::max<std::size_t>(small.length(), 1), 1);
+
+    return nanosecondsPerByte(large, 1) / nanosecondsPerByte(small, calls);
+}
+
+#endif //UWWWU_TEST_TIMING_H
@@ -0,0 +1,83 @@
+#include <WorkStealingPool.h>
+#include "Catch2.h"
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+// Tests that every index gets visited exactly once, no matter the pool's size, and that a pool can be reused
+TEST_CASE(__FILE__"/VisitsEveryIndexOnce", "[]")
+{
+    for (const std::size_t threads : { 1, 2, 3, 8 })
+    {
+        // Setup
+        WorkStealingPool pool(threads);
+
+        for (const std::size_t count : { 0, 1, 2, 7, 1000 })
+        {
+            std::vector<std::atomic<int>> visits(count);
+
+            // Exercise
+            pool.ForEach(count, [&](std::size_t i) { visits[i]++; });
+
+            // Verify
+            for (const std::atomic<int>& v : visits)
+                REQUIRE(v == 1);
+        }
+    }
+}
+
+// Tests that a few slow tasks among lots of quick ones still get everything done
+TEST_CASE(__FILE__"/UnevenTasks", "[]")
+{
+    // Setup
+    WorkStealingPool pool(4);
+    std::atomic<std::size_t> sum{ 0 };
+
+    // Exercise
+    pool.ForEach(200, [&](std::size_t i) {
+        std::size_t spin = (i % 50 == 0) ? 2000000 : 10;
+        volatile std::size_t x = 0;
+        while (spin--)
+            x = x + 1;
+        sum += i;
+    });
+
+    // Verify
+    REQUIRE(sum == 199 * 200 / 2);
+}
+
+// Tests that calling ForEach from within a task doesn't deadlock
+TEST_CASE(__FILE__"/Nested", "[]")
+{
+    // Setup
+    WorkStealingPool pool(4);
+    std::atomic<std::size_t> visits{ 0 };
+
+    // Exercise
+    pool.ForEach(10, [&](std::size_t) {
+        pool.ForEach(10, [&](std::size_t) { visits++; });
+    });
+
+    // Verify
+    REQUIRE(visits == 100);
+}
+
+// Tests that an exception thrown by a task ends up with the caller, after all other tasks are done
+TEST_CASE(__FILE__"/RethrowsException", "[]")
+{
+    // Setup
+    WorkStealingPool pool(4);
+    std::atomic<std::size_t> visits{ 0 };
+
+    // Exercise, Verify
+    REQUIRE_THROWS_AS(pool.ForEach(100, [&](std::size_t i) {
+        visits++;
+        if (i == 42)
+            throw std::runtime_error("oh no");
+    }), std::runtime_error);
+    REQUIRE(visits == 100);
+
+    // The pool is still good to use
+    pool.ForEach(10, [&](std::size_t) { visits++; });
+    REQUIRE(visits == 110);
+}